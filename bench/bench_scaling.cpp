@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+/*
+ * Multi-threaded scaling benchmark
+ *
+ * Every thread formats its own formatter set (independent memory, formatters and output buffers). Without shared
+ * mutable state in the formatting path the throughput scales linearly with the number of threads (as long as there
+ * are enough physical cores).
+ *
+ * usage: bench_memformat_scaling [MAX_THREADS] [VALUES] [ITERATIONS]
+ *     MAX_THREADS  maximum number of threads (default: number of hardware threads)
+ *     VALUES       number of formatted values per thread (default: 256)
+ *     ITERATIONS   number of times each thread formats all values (default: 20000)
+ */
+
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+//* formatting function that is measured
+enum class mode { FORMAT_TO, STRING };
+
+//* per thread result (cache line aligned to prevent false sharing)
+struct alignas(64) ThreadResult {
+    std::size_t checksum = 0;  //*< sum of the output lengths (prevents that the formatting is optimized away)
+};
+
+/**
+ * @brief create a formatter set with a mix of word sizes and formats
+ * @param memory memory that is formatted (8 bytes per value)
+ * @param values number of values
+ * @return formatter set
+ */
+static memformat::FormatterSet make_set(std::uint64_t *memory, std::size_t values) {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    static constexpr struct {
+        wordsize   w;
+        format     f;
+        endianness e;
+    } KINDS[] = {
+            {wordsize::BIT_8, format::UNSIGNED, endianness::HOST},
+            {wordsize::BIT_16, format::SIGNED, endianness::BIG},
+            {wordsize::BIT_32, format::HEX, endianness::LITTLE},
+            {wordsize::BIT_32, format::FLOAT, endianness::HOST},
+            {wordsize::BIT_64, format::UNSIGNED, endianness::BIG},
+            {wordsize::BIT_64, format::FLOAT, endianness::HOST},
+            {wordsize::BIT_16, format::BIN, endianness::HOST},
+            {wordsize::BIT_32, format::OCT, endianness::HOST},
+    };
+
+    memformat::FormatterSet set;
+    for (std::size_t i = 0; i < values; ++i) {
+        const auto &kind = KINDS[i % (sizeof(KINDS) / sizeof(KINDS[0]))];
+        set.add("v" + std::to_string(i),
+                memformat::MemoryFormatter::get_formatter(memory, i * sizeof(std::uint64_t), kind.w, kind.f, kind.e));
+    }
+    return set;
+}
+
+/**
+ * @brief benchmark thread
+ * @param m formatting function
+ * @param values number of values
+ * @param iterations number of iterations
+ * @param ready number of threads that are ready to start
+ * @param start start flag
+ * @param result thread result
+ */
+static void worker(mode                    m,
+                   std::size_t             values,
+                   std::size_t             iterations,
+                   std::atomic<unsigned>  &ready,
+                   const std::atomic_bool &start,
+                   ThreadResult           &result) {
+    // thread local memory, formatters and output buffer (first touch by the thread that uses them)
+    std::vector<std::uint64_t> memory(values);
+    for (std::size_t i = 0; i < values; ++i)
+        memory[i] = 0x9E3779B97F4A7C15ULL * (i + 1);
+    const auto set = make_set(memory.data(), values);
+
+    std::vector<char> buffer(memformat::MAX_STRING_LENGTH * values);
+
+    ready.fetch_add(1, std::memory_order_release);
+    while (!start.load(std::memory_order_acquire))
+        std::this_thread::yield();
+
+    std::size_t checksum = 0;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        if (m == mode::FORMAT_TO) {
+            char *p = buffer.data();
+            for (const auto &entry : set)
+                p = entry.formatter->format_to(p);
+            checksum += static_cast<std::size_t>(p - buffer.data());
+        } else {
+            for (const auto &entry : set)
+                checksum += entry.formatter->string().size();
+        }
+    }
+
+    result.checksum = checksum;
+}
+
+/**
+ * @brief run the benchmark with a number of threads
+ * @param m formatting function
+ * @param threads number of threads
+ * @param values number of values per thread
+ * @param iterations number of iterations per thread
+ * @return formatted values per second
+ */
+static double run(mode m, unsigned threads, std::size_t values, std::size_t iterations) {
+    std::atomic<unsigned>     ready {0};
+    std::atomic_bool          start {false};
+    std::vector<ThreadResult> results(threads);
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        workers.emplace_back(worker, m, values, iterations, std::ref(ready), std::cref(start), std::ref(results[i]));
+
+    while (ready.load(std::memory_order_acquire) != threads)
+        std::this_thread::yield();
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto &thread : workers)
+        thread.join();
+    const auto end = std::chrono::steady_clock::now();
+
+    std::size_t checksum = 0;
+    for (const auto &result : results)
+        checksum += result.checksum;
+    if (checksum == 0) std::fprintf(stderr, "unexpected empty output\n");
+
+    const auto seconds = std::chrono::duration<double>(end - begin).count();
+    return static_cast<double>(threads) * static_cast<double>(values) * static_cast<double>(iterations) / seconds;
+}
+
+/**
+ * @brief parse positive number from the command line
+ * @param str argument
+ * @param fallback value that is returned if the argument is invalid
+ * @return number
+ */
+static std::size_t parse(const char *str, std::size_t fallback) {
+    char      *end   = nullptr;
+    const auto value = std::strtoull(str, &end, 10);
+    return end != str && *end == '\0' && value > 0 ? static_cast<std::size_t>(value) : fallback;
+}
+
+int main(int argc, char **argv) {
+    const auto hardware    = std::max(std::thread::hardware_concurrency(), 1U);
+    const auto max_threads = static_cast<unsigned>(argc > 1 ? parse(argv[1], hardware) : hardware);
+    const auto values      = argc > 2 ? parse(argv[2], 256) : std::size_t {256};
+    const auto iterations  = argc > 3 ? parse(argv[3], 20000) : std::size_t {20000};
+
+    // 1, 2, 4, ... and max_threads
+    std::vector<unsigned> thread_counts;
+    for (unsigned n = 1; n < max_threads; n *= 2)
+        thread_counts.push_back(n);
+    thread_counts.push_back(max_threads);
+
+    std::printf("%zu values per thread, %zu iterations\n\n", values, iterations);
+    std::printf("%-10s %8s %16s %10s %12s\n", "function", "threads", "values/s", "speedup", "efficiency");
+
+    for (const auto m : {mode::FORMAT_TO, mode::STRING}) {
+        const char *name = m == mode::FORMAT_TO ? "format_to" : "string";
+
+        double single = 0;
+        for (const auto threads : thread_counts) {
+            const auto rate = run(m, threads, values, iterations);
+            if (threads == 1) single = rate;
+
+            const auto speedup = rate / single;
+            std::printf("%-10s %8u %16.0f %10.2f %11.1f%%\n",
+                        name,
+                        threads,
+                        rate,
+                        speedup,
+                        100.0 * speedup / static_cast<double>(threads));
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief decodes the values of many memory images into typed columns
+ * @details The layout (offsets, word sizes, formats and endianness) is taken from a formatter set. The memory images
+ *          are stored in a single buffer with a fixed distance (stride) between two images, e.g. the slots of a
+ *          SampleRing or the frames of a recording. Each image has the layout of the memory region of the set (see
+ *          FormatterSet::region).
+ *
+ *          The values are decoded without formatting them as text. Every column is decoded by a loop that is
+ *          specialized for word size, endianness and value type at compile time (the loop body contains no branches
+ *          and can be vectorized by the compiler).
+ */
+class BatchDecoder {
+public:
+    /**
+     * @brief type of the decoded values of a field
+     */
+    enum class value_type {
+        BIT,       //*< 0 or 1 (word size BIT_1)
+        SIGNED,    //*< signed integer (format SIGNED)
+        UNSIGNED,  //*< unsigned integer (formats UNSIGNED, BIN, OCT, HEX and LABEL)
+        FLOAT,     //*< floating point (format FLOAT)
+    };
+
+    /**
+     * @brief field of the layout
+     */
+    struct Field {
+        std::string name;       //*< name of the formatter
+        std::size_t offset;     //*< offset of the first byte relative to the start of an image
+        wordsize    word_size;  //*< word size
+        endianness  endian;     //*< endianness
+        std::size_t bit_index;  //*< bit index (BIT_1)
+        value_type  type;       //*< value type
+    };
+
+    //* decoded column (type depends on Field::type)
+    using Column = std::variant<std::vector<std::uint8_t>,   // BIT
+                                std::vector<std::int64_t>,   // SIGNED
+                                std::vector<std::uint64_t>,  // UNSIGNED
+                                std::vector<double>>;        // FLOAT
+
+private:
+    std::vector<Field> layout;      //*< fields (same order as the formatter set)
+    std::size_t        image_size;  //*< size of the memory region of the set
+
+public:
+    /**
+     * @brief construct BatchDecoder
+     * @param set formatters that define the layout (the set can be destroyed afterwards)
+     *
+     * @exception std::invalid_argument the formatters have different base addresses or a formatter writes a character
+     *                                  field (format::STRING)
+     */
+    explicit BatchDecoder(const FormatterSet &set);
+
+    /**
+     * @brief decode one field of multiple images into a typed array
+     * @details The values are converted to the output type with static_cast.
+     * @param field field index
+     * @param images start of the first image
+     * @param count number of images
+     * @param stride distance between two images in bytes (at least get_image_size())
+     * @param out output array (count elements)
+     *
+     * @exception std::invalid_argument stride is smaller than the image size
+     */
+    void decode(std::size_t field, const void *images, std::size_t count, std::size_t stride, std::uint8_t *out) const;
+    void decode(std::size_t field, const void *images, std::size_t count, std::size_t stride, std::int64_t *out) const;
+    void decode(std::size_t field, const void *images, std::size_t count, std::size_t stride, std::uint64_t *out) const;
+    void decode(std::size_t field, const void *images, std::size_t count, std::size_t stride, double *out) const;
+
+    /**
+     * @brief decode all fields of multiple images
+     * @param images start of the first image
+     * @param count number of images
+     * @param stride distance between two images in bytes (at least get_image_size())
+     * @return one column per field (same order as the formatter set), each with count values of the natural type of
+     *         the field
+     *
+     * @exception std::invalid_argument stride is smaller than the image size
+     */
+    [[nodiscard]] std::vector<Column> decode_all(const void *images, std::size_t count, std::size_t stride) const;
+
+    /**
+     * @brief get the fields of the layout
+     * @return fields
+     */
+    [[nodiscard]] const std::vector<Field> &fields() const { return layout; }
+
+    /**
+     * @brief get size of a memory image
+     * @return size in bytes (size of the memory region of the formatter set)
+     */
+    [[nodiscard]] std::size_t get_image_size() const { return image_size; }
+
+private:
+    /**
+     * @brief decode one field of multiple images into a typed array
+     * @tparam Out output type
+     * @param field field index
+     * @param images start of the first image
+     * @param count number of images
+     * @param stride distance between two images in bytes
+     * @param out output array (count elements)
+     */
+    template <typename Out>
+    void decode_field(std::size_t field, const void *images, std::size_t count, std::size_t stride, Out *out) const;
+};
+
+}  // namespace memformat
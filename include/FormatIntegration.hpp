@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+/**
+ * @file FormatIntegration.hpp
+ * @brief formatter specializations for std::format and fmt
+ * @details MemoryFormatter and FormatResult can be passed directly to std::format (if the standard library supports
+ *          it) and fmt::format (if <fmt/format.h> is available and MEMFORMAT_NO_FMT is not defined). The value is
+ *          formatted into a stack buffer and written to the output iterator of the format context without creating a
+ *          std::string.
+ *
+ *          Format spec: [[fill]align][#][0][width]
+ *              - fill: fill character (default: space)
+ *              - align: '<' left, '>' right (default), '^' center
+ *              - '#': prefix depending on the output format of the formatter (0x: HEX, 0b: BIN, 0: OCT)
+ *              - '0': pad with zeros behind the sign and the prefix (ignored if align is specified)
+ *              - width: minimum number of characters
+ *
+ *          Example: fmt::format("{}: {:#010}", name, *formatter)
+ */
+
+#include "MemoryFormatter.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#if __has_include(<version>)
+#    include <version>
+#endif
+
+#if defined(__cpp_lib_format)
+#    include <format>
+#endif
+
+#if !defined(MEMFORMAT_NO_FMT) && __has_include(<fmt/format.h>)
+#    include <fmt/format.h>
+#    define MEMFORMAT_FMT_FORMATTER
+#endif
+
+namespace memformat::detail {
+
+/**
+ * @brief parsed format spec of the std::format and fmt formatters
+ */
+struct FormatSpec {
+    char        fill      = ' ';    //*< fill character
+    char        align     = '\0';   //*< alignment ('<', '>', '^' or '\0' if not specified)
+    bool        alternate = false;  //*< write prefix ('#')
+    bool        zero_pad  = false;  //*< pad with zeros ('0')
+    std::size_t width     = 0;      //*< minimum number of characters
+
+    /**
+     * @brief parse format spec
+     * @tparam It iterator type
+     * @param it first character of the format spec
+     * @param end end of the format string
+     * @return iterator to the first character that is not part of the spec (must be '}' or end for a valid spec)
+     */
+    template <typename It>
+    constexpr It parse(It it, It end) {
+        auto is_align = [](char c) { return c == '<' || c == '>' || c == '^'; };
+
+        if (it != end && it + 1 != end && is_align(*(it + 1)) && *it != '{' && *it != '}') {
+            fill  = *it;
+            align = *(it + 1);
+            it += 2;
+        } else if (it != end && is_align(*it)) {
+            align = *it;
+            ++it;
+        }
+
+        if (it != end && *it == '#') {
+            alternate = true;
+            ++it;
+        }
+
+        if (it != end && *it == '0') {
+            zero_pad = true;
+            ++it;
+        }
+
+        for (; it != end && *it >= '0' && *it <= '9'; ++it)
+            width = width * 10 + static_cast<std::size_t>(*it - '0');
+
+        return it;
+    }
+
+    /**
+     * @brief write formatted value with prefix and padding
+     * @tparam OutputIt output iterator type
+     * @param out output iterator
+     * @param value formatted value
+     * @param prefix prefix (only written if alternate is set)
+     * @return output iterator behind the last written character
+     */
+    template <typename OutputIt>
+    OutputIt write(OutputIt out, std::string_view value, std::string_view prefix) const {
+        if (!alternate) prefix = {};
+
+        std::string_view sign;
+        if (!value.empty() && value.front() == '-') {
+            sign = value.substr(0, 1);
+            value.remove_prefix(1);
+        }
+
+        const auto length = sign.size() + prefix.size() + value.size();
+        const auto fill_n = width > length ? width - length : 0;
+
+        if (zero_pad && align == '\0') {
+            out = std::copy(sign.begin(), sign.end(), out);
+            out = std::copy(prefix.begin(), prefix.end(), out);
+            out = std::fill_n(out, fill_n, '0');
+            return std::copy(value.begin(), value.end(), out);
+        }
+
+        const std::size_t before = align == '<' ? 0 : align == '^' ? fill_n / 2 : fill_n;
+
+        out = std::fill_n(out, before, fill);
+        out = std::copy(sign.begin(), sign.end(), out);
+        out = std::copy(prefix.begin(), prefix.end(), out);
+        out = std::copy(value.begin(), value.end(), out);
+        return std::fill_n(out, fill_n - before, fill);
+    }
+};
+
+/**
+ * @brief get the prefix of an output format
+ * @param f output format
+ * @return prefix ("0x", "0b", "0" or empty)
+ */
+constexpr std::string_view format_prefix(format f) {
+    switch (f) {
+        case format::BIN: return "0b";
+        case format::OCT: return "0";
+        case format::HEX: return "0x";
+        case format::SIGNED:
+        case format::UNSIGNED:
+        case format::FLOAT:
+        case format::LABEL:
+        case format::STRING: return {};
+    }
+    return {};
+}
+
+/**
+ * @brief write the formatted value of a formatter to an output iterator
+ * @tparam OutputIt output iterator type
+ * @param out output iterator
+ * @param formatter formatter
+ * @param spec format spec
+ * @return output iterator behind the last written character
+ */
+template <typename OutputIt>
+OutputIt write_formatted(OutputIt out, const MemoryFormatter &formatter, const FormatSpec &spec) {
+    char       buffer[MAX_STRING_LENGTH];
+    const auto end = formatter.format_to(buffer);
+    return spec.write(out,
+                      std::string_view(buffer, static_cast<std::size_t>(end - buffer)),
+                      format_prefix(formatter.get_format()));
+}
+
+}  // namespace memformat::detail
+
+#if defined(__cpp_lib_format)
+/**
+ * @brief std::format support for MemoryFormatter
+ */
+template <>
+struct std::formatter<memformat::MemoryFormatter> {
+    memformat::detail::FormatSpec spec;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = spec.parse(ctx.begin(), ctx.end());
+        if (it != ctx.end() && *it != '}')
+            throw std::format_error("invalid format spec for memformat::MemoryFormatter");
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const memformat::MemoryFormatter &formatter, FormatContext &ctx) const {
+        return memformat::detail::write_formatted(ctx.out(), formatter, spec);
+    }
+};
+
+/**
+ * @brief std::format support for FormatResult
+ */
+template <>
+struct std::formatter<memformat::FormatResult> {
+    memformat::detail::FormatSpec spec;
+
+    constexpr auto parse(std::format_parse_context &ctx) {
+        auto it = spec.parse(ctx.begin(), ctx.end());
+        if (it != ctx.end() && *it != '}')
+            throw std::format_error("invalid format spec for memformat::FormatResult");
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const memformat::FormatResult &result, FormatContext &ctx) const {
+        return spec.write(ctx.out(), result.view(), {});
+    }
+};
+#endif
+
+#ifdef MEMFORMAT_FMT_FORMATTER
+/**
+ * @brief fmt support for MemoryFormatter
+ */
+template <>
+struct fmt::formatter<memformat::MemoryFormatter> {
+    memformat::detail::FormatSpec spec;
+
+    constexpr auto parse(fmt::format_parse_context &ctx) -> decltype(ctx.begin()) {
+        auto it = spec.parse(ctx.begin(), ctx.end());
+        if (it != ctx.end() && *it != '}')
+            throw fmt::format_error("invalid format spec for memformat::MemoryFormatter");
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const memformat::MemoryFormatter &formatter, FormatContext &ctx) const -> decltype(ctx.out()) {
+        return memformat::detail::write_formatted(ctx.out(), formatter, spec);
+    }
+};
+
+/**
+ * @brief fmt support for FormatResult
+ */
+template <>
+struct fmt::formatter<memformat::FormatResult> {
+    memformat::detail::FormatSpec spec;
+
+    constexpr auto parse(fmt::format_parse_context &ctx) -> decltype(ctx.begin()) {
+        auto it = spec.parse(ctx.begin(), ctx.end());
+        if (it != ctx.end() && *it != '}')
+            throw fmt::format_error("invalid format spec for memformat::FormatResult");
+        return it;
+    }
+
+    template <typename FormatContext>
+    auto format(const memformat::FormatResult &result, FormatContext &ctx) const -> decltype(ctx.out()) {
+        return spec.write(ctx.out(), result.view(), {});
+    }
+};
+#endif
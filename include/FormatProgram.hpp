@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief output template that is compiled into a sequence of operations
+ * @details A template like "{name}: 0x{hex:08} ({unsigned}) {float:.3}" is parsed once by the constructor into
+ *          literal copies and typed conversions. Executing the program writes the output for a formatter into a
+ *          caller buffer without parsing the template or allocating memory. The memory value is read only once per
+ *          execution (except for the conversion value, which calls the formatter).
+ *
+ *          Placeholders have the form {conversion} or {conversion:spec}. {{ and }} are literal braces.
+ *
+ *          Conversions:
+ *              - name: name of the value
+ *              - value: output of the formatter (see MemoryFormatter::format_to)
+ *              - bin, oct, hex, HEX: raw value (see MemoryFormatter::raw) as binary, octal or hexadecimal number
+ *                (HEX: uppercase digits). bin writes all bits of the word size.
+ *              - unsigned: raw value as unsigned integer
+ *              - signed: raw value as signed integer of the word size
+ *              - float: raw value as float (32 bit) or double (64 bit) in fixed notation
+ *
+ *          Spec: [-][0][width][.precision]
+ *              - '-': left align (default: right align)
+ *              - '0': pad numbers with zeros instead of spaces (the sign stays in front)
+ *              - width: minimum number of characters
+ *              - precision: number of decimals (only for float, default: 6)
+ */
+class FormatProgram {
+public:
+    //* maximum width of a placeholder
+    static constexpr std::size_t MAX_WIDTH = 1024;
+
+    //* maximum precision of the float conversion
+    static constexpr std::size_t MAX_PRECISION = 64;
+
+    /**
+     * @brief operation type
+     */
+    enum class operation {
+        LITERAL,    //*< copy literal text
+        NAME,       //*< name of the value
+        VALUE,      //*< output of the formatter
+        BIN,        //*< binary number
+        OCT,        //*< octal number
+        HEX,        //*< hexadecimal number (lowercase digits)
+        HEX_UPPER,  //*< hexadecimal number (uppercase digits)
+        UNSIGNED,   //*< unsigned integer
+        SIGNED,     //*< signed integer
+        FLOAT,      //*< floating point number
+    };
+
+    /**
+     * @brief compiled operation
+     */
+    struct Op {
+        operation   type;                    //*< operation type
+        std::size_t literal_offset = 0;      //*< offset of the literal text (LITERAL)
+        std::size_t literal_size   = 0;      //*< size of the literal text (LITERAL)
+        std::size_t width          = 0;      //*< minimum number of characters
+        std::size_t precision      = 6;      //*< number of decimals (FLOAT)
+        bool        left_align     = false;  //*< left align instead of right align
+        bool        zero_pad       = false;  //*< pad with zeros instead of spaces
+    };
+
+private:
+    std::string     literals;           //*< literal text of all LITERAL operations
+    std::vector<Op> program;            //*< compiled operations
+    bool            needs_raw = false;  //*< true if at least one operation converts the raw value
+
+public:
+    /**
+     * @brief compile template
+     * @param pattern output template
+     *
+     * @exception std::invalid_argument invalid template (unmatched brace, unknown conversion or invalid spec)
+     */
+    explicit FormatProgram(std::string_view pattern);
+
+    /**
+     * @brief get compiled operations
+     * @return operations
+     */
+    [[nodiscard]] const std::vector<Op> &operations() const { return program; }
+
+    /**
+     * @brief get the maximum number of characters that are written by one execution
+     * @param name_length length of the longest name
+     * @return maximum output size
+     */
+    [[nodiscard]] std::size_t max_size(std::size_t name_length = 0) const;
+
+    /**
+     * @brief execute program
+     * @param dest output buffer (at least max_size(name.size()) characters)
+     * @param formatter formatter that defines the value
+     * @param name name of the value
+     * @return pointer behind the last written character
+     *
+     * @exception std::invalid_argument float conversion of a value that is not 32 or 64 bit
+     */
+    char *format_to(char *dest, const MemoryFormatter &formatter, std::string_view name = {}) const {
+        return format_to(formatter.get_base_address(), dest, formatter, name);
+    }
+
+    /**
+     * @brief execute program for the value of another memory region
+     * @param base base memory address the value is read from (see MemoryFormatter::format_to)
+     * @param dest output buffer (at least max_size(name.size()) characters)
+     * @param formatter formatter that defines the value
+     * @param name name of the value
+     * @param access memory access semantics
+     * @return pointer behind the last written character
+     *
+     * @exception std::invalid_argument float conversion of a value that is not 32 or 64 bit
+     */
+    char *format_to(volatile void         *base,
+                    char                  *dest,
+                    const MemoryFormatter &formatter,
+                    std::string_view       name   = {},
+                    memory_access          access = memory_access::VOLATILE) const;
+
+    /**
+     * @brief execute program for an entry of a formatter set
+     * @param dest output buffer (at least max_size(entry.name.size()) characters)
+     * @param entry formatter set entry
+     * @return pointer behind the last written character
+     */
+    char *format_to(char *dest, const FormatterSet::Entry &entry) const {
+        return format_to(dest, *entry.formatter, entry.name);
+    }
+
+    /**
+     * @brief execute program and append the output to a string
+     * @param out output string
+     * @param entry formatter set entry
+     * @param access memory access semantics
+     */
+    void append_to(std::string               &out,
+                   const FormatterSet::Entry &entry,
+                   memory_access              access = memory_access::VOLATILE) const;
+
+    /**
+     * @brief execute program for all entries of a formatter set and append the output to a string
+     * @details every output is followed by a newline. The values are read with the access semantics of the set.
+     * @param out output string
+     * @param set formatter set
+     */
+    void append_to(std::string &out, const FormatterSet &set) const;
+
+    /**
+     * @brief execute program
+     * @param entry formatter set entry
+     * @return output
+     */
+    [[nodiscard]] std::string string(const FormatterSet::Entry &entry) const;
+};
+
+}  // namespace memformat
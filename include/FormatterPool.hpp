@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief interning factory for memory formatters
+ * @details get() returns the same formatter instance for identical arguments (base address, offset, word size, format,
+ *          endianness and bit index; arguments that are ignored by MemoryFormatter::get_formatter are not compared).
+ *          Components that request the same value share a single formatter, a FormatterSet detects such entries with
+ *          FormatterSet::duplicates(). MemoryFormatter::get_formatter interns its formatters in global().
+ *
+ *          The pool only holds weak references: a formatter is destroyed when the last user releases it.
+ *
+ *          Lookups are lock-free: every shard publishes an open addressing hash table whose slots are atomic pointers
+ *          to immutable entries. Insertions lock their shard, fill an empty slot (or replace the expired entry of the
+ *          same key) and rebuild the table without the expired entries when it is half full (amortized constant
+ *          cost). Replaced entries and tables are freed in batches after all lookups that may still read them have
+ *          finished (epoch based reclamation with striped reader counters).
+ *
+ *          Sharing is safe because formatters are immutable: the memory access semantics are a property of the
+ *          FormatterSet (see FormatterSet::set_access), not of the formatter.
+ */
+class FormatterPool {
+private:
+    //* formatter arguments
+    struct Key {
+        std::uintptr_t base;       //*< base address
+        std::size_t    offset;     //*< memory offset
+        std::size_t    bit_index;  //*< bit index (BIT_1)
+        wordsize       w;          //*< word size
+        format         f;          //*< output format
+        endianness     e;          //*< endianness
+
+        bool operator==(const Key &other) const {
+            return base == other.base && offset == other.offset && bit_index == other.bit_index && w == other.w &&
+                   f == other.f && e == other.e;
+        }
+    };
+
+    //* hash function of Key
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    //* interned formatter (immutable while it is published)
+    struct Node {
+        Key                            key;        //*< formatter arguments
+        std::weak_ptr<MemoryFormatter> formatter;  //*< formatter (expired if no longer in use)
+    };
+
+    //* open addressing hash table with linear probing (entries are never removed from a published table)
+    struct Table {
+        std::size_t                            mask;   //*< number of slots - 1 (number of slots is a power of 2)
+        std::unique_ptr<std::atomic<Node *>[]> slots;  //*< entries (nullptr: empty slot)
+
+        explicit Table(std::size_t size);
+    };
+
+    //* size of a cache line (alignment of data that is modified by different threads)
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    //* minimal number of slots of a table and minimal batch size of the reclamation
+    static constexpr std::size_t MIN_SIZE = 16;
+
+    //* hash table of a shard
+    struct alignas(CACHE_LINE) Shard {
+        std::atomic<Table *> table {nullptr};  //*< published table (read without lock)
+
+        //* serializes modifications of the shard (separate cache line: locking does not slow down lookups)
+        alignas(CACHE_LINE) mutable std::mutex mutex;
+
+        std::size_t          used = 0;        //*< occupied slots of table (including expired entries)
+        std::vector<Node *>  retired_nodes;   //*< replaced entries that may still be read by lookups
+        std::vector<Table *> retired_tables;  //*< replaced tables that may still be read by lookups
+    };
+
+    //* number of shards (power of 2)
+    static constexpr std::size_t SHARDS = 16;
+
+    //* shards (selected by the hash of the key)
+    std::array<Shard, SHARDS> shards;
+
+    //* active lookups of a group of threads (one counter per epoch parity)
+    struct alignas(CACHE_LINE) ReaderStripe {
+        std::array<std::atomic<std::size_t>, 2> active {};
+    };
+
+    //* number of reader stripes
+    static constexpr std::size_t STRIPES = 16;
+
+    std::array<ReaderStripe, STRIPES> readers;        //*< active lookups
+    std::atomic<std::size_t>          epoch {0};      //*< lookups register with the counter of the epoch parity
+    std::mutex                        reclaim_mutex;  //*< serializes grace periods
+
+    //* registers a lookup for the lifetime of the object
+    class ReadGuard {
+    private:
+        std::atomic<std::size_t> &counter;
+
+    public:
+        explicit ReadGuard(FormatterPool &pool);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard &)            = delete;
+        ReadGuard(ReadGuard &&)                 = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ReadGuard &operator=(ReadGuard &&)      = delete;
+    };
+
+public:
+    FormatterPool() = default;
+
+    FormatterPool(const FormatterPool &)            = delete;
+    FormatterPool(FormatterPool &&)                 = delete;
+    FormatterPool &operator=(const FormatterPool &) = delete;
+    FormatterPool &operator=(FormatterPool &&)      = delete;
+
+    ~FormatterPool();
+
+    /**
+     * @brief get the interned formatter for the arguments (created on first use)
+     * @details see MemoryFormatter::get_formatter for a description of the arguments
+     * @return shared formatter instance
+     *
+     * @exception std::invalid_argument: invalid combination of word size, format and endianness
+     * @exception std::out_of_range: bit index out of range (only relevant for w == BIT_1)
+     */
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> get(void       *base_addr,
+                                                       std::size_t offset,
+                                                       wordsize    w,
+                                                       format      f         = format::BIN,
+                                                       endianness  e         = endianness::HOST,
+                                                       std::size_t bit_index = 0);
+
+    /**
+     * @brief get the interned formatter for the arguments (created on first use)
+     * @details see MemoryFormatter::get_formatter for a description of the arguments
+     * @return shared formatter instance
+     *
+     * @exception std::invalid_argument: address string is invalid
+     * @exception std::out_of_range: bit index out of range (only relevant for w == BIT_1)
+     */
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> get(void              *base_addr,
+                                                       const std::string &addr_string,
+                                                       wordsize           w,
+                                                       format             f = format::BIN,
+                                                       endianness         e = endianness::HOST);
+
+    /**
+     * @brief get number of interned formatters that are still in use
+     * @return number of formatters
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief remove the entries of formatters that are no longer in use
+     * @details expired entries of a shard are also removed by an insertion that fills half of the table of the shard
+     */
+    void purge();
+
+    /**
+     * @brief get the process wide pool
+     * @return pool
+     */
+    static FormatterPool &global();
+
+private:
+    /**
+     * @brief lock-free lookup
+     * @param table table (nullptr: empty shard)
+     * @param key key
+     * @param hash hash of the key
+     * @return formatter or nullptr if the key is not in the table or its formatter expired
+     */
+    [[nodiscard]] static std::shared_ptr<MemoryFormatter> find(const Table *table, const Key &key, std::size_t hash);
+
+    /**
+     * @brief replace the table of a shard by a table that only contains the formatters that are still in use
+     * @details the mutex of the shard must be held
+     * @param shard shard
+     * @param extra number of entries that will be inserted
+     */
+    void rebuild(Shard &shard, std::size_t extra);
+
+    /**
+     * @brief free the retired entries and tables of a shard (waits until all running lookups finished)
+     * @details the mutex of the shard must be held
+     * @param shard shard
+     */
+    void reclaim(Shard &shard);
+
+    /**
+     * @brief wait until all lookups that started before the call finished
+     */
+    void synchronize();
+};
+
+}  // namespace memformat
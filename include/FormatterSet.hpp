@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief named collection of memory formatters that are formatted together
+ * @details The set also stores the memory access semantics that are used by the consumers of the set (output sinks,
+ *          MultiImageFormatter, FormatProgram, ...). The formatters themselves are immutable: copies of a set and
+ *          other sets can share formatter instances without sharing the access semantics.
+ */
+class FormatterSet {
+public:
+    /**
+     * @brief formatter set entry
+     */
+    struct Entry {
+        std::string                      name;       //*< name of the value
+        std::shared_ptr<MemoryFormatter> formatter;  //*< formatter instance
+    };
+
+    /**
+     * @brief contiguous memory region
+     */
+    struct Region {
+        volatile void *address = nullptr;  //*< address of the first byte
+        std::size_t    size    = 0;        //*< number of bytes
+    };
+
+private:
+    std::vector<Entry> entries;                             //*< formatters
+    memory_access      access = memory_access::VOLATILE;  //*< memory access semantics of the consumers
+
+public:
+    FormatterSet() = default;
+
+    /**
+     * @brief add formatter
+     * @param name name of the value
+     * @param formatter formatter instance
+     *
+     * @exception std::invalid_argument formatter is a nullptr
+     */
+    void add(std::string name, std::shared_ptr<MemoryFormatter> formatter);
+
+    /**
+     * @brief add formatter without taking ownership
+     * @details The set stores a non-owning pointer (copying the set does not modify any reference count).
+     *          Intended for formatters that are created in a memory resource (see FormatterHandle).
+     * @param name name of the value
+     * @param formatter formatter instance (must outlive the set and all copies of the set)
+     */
+    void add_unowned(std::string name, MemoryFormatter &formatter);
+
+    /**
+     * @brief create and add formatter
+     * @details see MemoryFormatter::get_formatter for a description of the arguments
+     * @return the created formatter
+     */
+    std::shared_ptr<MemoryFormatter> add(std::string        name,
+                                         void              *base_addr,
+                                         const std::string &addr_string,
+                                         wordsize           w,
+                                         format             f = format::BIN,
+                                         endianness         e = endianness::HOST);
+
+    /**
+     * @brief get number of formatters
+     * @return number of formatters
+     */
+    [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+    /**
+     * @brief check whether the set is empty
+     * @return true if the set contains no formatters
+     */
+    [[nodiscard]] bool empty() const { return entries.empty(); }
+
+    /**
+     * @brief get entry by index
+     * @param index entry index
+     * @return entry
+     */
+    [[nodiscard]] const Entry &operator[](std::size_t index) const { return entries[index]; }
+
+    /**
+     * @brief get the memory region that is read by the formatters of the set
+     * @return smallest region that contains the values of all formatters (size 0 if the set is empty)
+     *
+     * @exception std::invalid_argument the formatters have different base addresses
+     */
+    [[nodiscard]] Region region() const;
+
+    /**
+     * @brief detect entries that share a formatter instance
+     * @details Entries with the same formatter instance (e.g. interned formatters, see FormatterPool) format the same
+     *          value. The output sinks and MultiImageFormatter format every instance once and copy the output
+     *          for the other entries.
+     * @return index of the first entry with the same formatter instance for each entry (i for the first occurrence)
+     */
+    [[nodiscard]] std::vector<std::size_t> duplicates() const;
+
+    /**
+     * @brief create a set that contains every formatter instance only once
+     * @details The entries keep the order and the name of their first occurrence. The access semantics are copied.
+     * @return formatter set without duplicates
+     */
+    [[nodiscard]] FormatterSet unique() const;
+
+    /**
+     * @brief create a copy of the set that reads from a copy of the memory region
+     * @details Entry i of the new set formats the same value as entry i of this set, but reads it from region_copy.
+     *          Entries that share a formatter instance also share the relocated formatter.
+     *          The new set uses plain loads (memory_access::PLAIN), the access semantics of this set are not modified.
+     * @param region_copy copy of the memory region returned by region() (must outlive the created set)
+     * @return formatter set
+     */
+    [[nodiscard]] FormatterSet rebind(void *region_copy) const;
+
+    /**
+     * @brief set the memory access semantics of the set
+     * @details Consumers copy the access semantics when they are constructed from the set. The formatters are not
+     *          modified.
+     * @param mode memory access semantics
+     */
+    void set_access(memory_access mode) { access = mode; }
+
+    /**
+     * @brief get the memory access semantics of the set
+     * @return memory access semantics
+     */
+    [[nodiscard]] memory_access get_access() const { return access; }
+
+    [[nodiscard]] std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    [[nodiscard]] std::vector<Entry>::const_iterator end() const { return entries.end(); }
+};
+
+}  // namespace memformat
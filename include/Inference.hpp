@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief expected values for infer_interpretations
+ */
+struct InferenceHint {
+    double min = -std::numeric_limits<double>::infinity();  //*< smallest expected value
+    double max = std::numeric_limits<double>::infinity();   //*< largest expected value
+
+    //* distance between two values in bytes (0: word size of the evaluated interpretation)
+    std::size_t stride = 0;
+
+    //* evaluated word sizes (BIT_1 is not supported)
+    std::vector<wordsize> word_sizes {wordsize::BIT_8, wordsize::BIT_16, wordsize::BIT_32, wordsize::BIT_64};
+
+    //* evaluated formats (only SIGNED, UNSIGNED and FLOAT are supported, the other formats are representations of
+    //* UNSIGNED)
+    std::vector<format> formats {format::SIGNED, format::UNSIGNED, format::FLOAT};
+};
+
+/**
+ * @brief rated interpretation of memory values
+ */
+struct Interpretation {
+    wordsize    word_size;      //*< word size
+    endianness  endian;         //*< endianness
+    format      output_format;  //*< format
+    std::size_t samples;        //*< number of evaluated values
+    std::size_t matches;        //*< number of values within the expected range
+    double      score;          //*< matches / samples
+    double      min;            //*< smallest matching value (NaN if there is no match)
+    double      max;            //*< largest matching value (NaN if there is no match)
+};
+
+/**
+ * @brief rate all interpretations (word size, endianness, format) of the values in a memory region
+ * @details The values at offset 0, stride, 2 * stride, ... are decoded for every combination of word size and
+ *          endianness in a single batch pass and compared against the expected range. Subnormal, infinite and NaN
+ *          floating point values never match.
+ *
+ *          endianness::HOST is not evaluated for word sizes > 8 bit (it is identical to BIG or LITTLE), 8 bit values
+ *          are only evaluated with endianness::HOST.
+ *
+ *          The results can be passed directly to MemoryFormatter::get_formatter.
+ * @param data memory region (e.g. a copy of a register block or consecutive samples of the same register)
+ * @param size size of the memory region in bytes
+ * @param hint expected values
+ * @return interpretations, sorted by score (best first)
+ *
+ * @exception std::invalid_argument hint is invalid
+ */
+[[nodiscard]] std::vector<Interpretation>
+        infer_interpretations(const void *data, std::size_t size, const InferenceHint &hint = {});
+
+}  // namespace memformat
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief formatter usage statistics
+ * @details The counters are only collected if the library is built with the CMake option INSTRUMENTATION
+ *          (MEMFORMAT_INSTRUMENTATION). Otherwise the formatting path contains no instrumentation code and all
+ *          counters are 0.
+ *
+ *          Every call of MemoryFormatter::format_to (and everything that is built on it: append_to, output sinks,
+ *          StreamWriter, ...) is counted per word size and format. The counters are updated with relaxed atomic
+ *          operations and can be read at any time from any thread.
+ */
+namespace memformat::instrumentation {
+
+#ifdef MEMFORMAT_INSTRUMENTATION
+constexpr bool ENABLED = true;  //*< instrumentation is compiled in
+#else
+constexpr bool ENABLED = false;  //*< instrumentation is not compiled in
+#endif
+
+constexpr std::size_t WORDSIZES = 5;  //*< number of memformat::wordsize values
+constexpr std::size_t FORMATS   = 8;  //*< number of memformat::format values
+
+//* number of histogram buckets
+constexpr std::size_t HISTOGRAM_BUCKETS = 16;
+
+/**
+ * @brief upper bound of a histogram bucket
+ * @param bucket bucket index
+ * @return inclusive upper bound in nanoseconds (16 ns * 2^bucket, the last bucket has no upper bound)
+ */
+constexpr std::uint64_t bucket_limit(std::size_t bucket) { return std::uint64_t {16} << bucket; }
+
+/**
+ * @brief counters of one word size / format combination
+ */
+struct Counters {
+    std::uint64_t calls         = 0;  //*< number of formatted values
+    std::uint64_t bytes_read    = 0;  //*< number of memory bytes read
+    std::uint64_t bytes_written = 0;  //*< number of output characters
+    std::uint64_t total_ns      = 0;  //*< total formatting time in nanoseconds
+
+    //* formatting time histogram (bucket i: bucket_limit(i - 1) < duration <= bucket_limit(i), not cumulative)
+    std::array<std::uint64_t, HISTOGRAM_BUCKETS> histogram {};
+
+    Counters &operator+=(const Counters &other);
+};
+
+/**
+ * @brief snapshot of all counters
+ */
+struct Snapshot {
+    std::array<std::array<Counters, FORMATS>, WORDSIZES> counters {};  //*< indexed by [wordsize][format]
+
+    /**
+     * @brief get counters of a word size / format combination
+     * @param w word size
+     * @param f format (always format::BIN for wordsize::BIT_1)
+     * @return counters
+     */
+    [[nodiscard]] const Counters &get(wordsize w, format f) const {
+        return counters[static_cast<std::size_t>(w)][static_cast<std::size_t>(f)];
+    }
+
+    /**
+     * @brief get the sum of all counters
+     * @return counters
+     */
+    [[nodiscard]] Counters total() const;
+};
+
+/**
+ * @brief get a snapshot of all counters
+ * @return snapshot (all counters are 0 if ENABLED is false)
+ */
+[[nodiscard]] Snapshot snapshot();
+
+/**
+ * @brief reset all counters to 0
+ */
+void reset();
+
+/**
+ * @brief format a snapshot in the Prometheus text exposition format
+ * @details Exports the metrics <prefix>_format_calls_total, <prefix>_format_read_bytes_total,
+ *          <prefix>_format_output_bytes_total and the histogram <prefix>_format_duration_nanoseconds with the labels
+ *          wordsize and format. Combinations without calls are omitted.
+ * @param snapshot snapshot
+ * @param prefix metric name prefix
+ * @return metrics
+ */
+[[nodiscard]] std::string prometheus_text(const Snapshot &snapshot, const std::string &prefix = "memformat");
+
+}  // namespace memformat::instrumentation
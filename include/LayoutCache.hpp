@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_POSIX
+
+#    include "FormatterSet.hpp"
+
+#    include <cstddef>
+#    include <memory>
+#    include <string>
+#    include <string_view>
+
+namespace memformat {
+
+/**
+ * @brief memory mapped binary file that stores the layout of a formatter set
+ * @details write() stores name, offset, word size, format, endianness and bit index of every formatter in a versioned
+ *          binary file (fixed size entries and a name table, host byte order). The memory access semantics of the set
+ *          and the entries that share a formatter instance (see FormatterSet::duplicates) are stored as well. The file
+ *          is replaced atomically: other processes never open a partially written file.
+ *
+ *          Opening the file maps it into memory and validates the header and a checksum of the content. The entries
+ *          are read directly from the mapped file, no address strings are parsed. Formatters are only created by
+ *          formatter() and create().
+ *
+ *          Only formatters that are created by MemoryFormatter::get_formatter (or FormatterSet::add) and share a single
+ *          base address can be stored. The base address is not stored, it is passed to formatter() and create().
+ *
+ *          The class is thread safe (all member functions are const).
+ */
+class LayoutCache {
+public:
+    /**
+     * @brief layout entry
+     */
+    struct Entry {
+        std::string_view name;       //*< name of the value (points into the mapped file)
+        std::size_t      offset;     //*< memory offset
+        wordsize         w;          //*< word size
+        format           f;          //*< output format
+        endianness       e;          //*< endianness
+        std::size_t      bit_index;  //*< bit index (BIT_1)
+        std::size_t      first;      //*< index of the first entry with the same formatter instance (own index if none)
+    };
+
+private:
+    const std::byte *file      = nullptr;                  //*< mapped file
+    std::size_t      file_size = 0;                        //*< size of the mapped file
+    std::size_t      count     = 0;                        //*< number of entries
+    memory_access    access    = memory_access::VOLATILE;  //*< memory access semantics of the stored set
+
+public:
+    /**
+     * @brief open layout cache file
+     * @param path layout cache file
+     * @param verify verify the checksum of the content (reads the whole file once)
+     *
+     * @exception std::system_error failed to open or map the file
+     * @exception std::runtime_error file is not a valid layout cache (wrong version, byte order, size or checksum)
+     */
+    explicit LayoutCache(const std::string &path, bool verify = true);
+
+    LayoutCache(const LayoutCache &)            = delete;
+    LayoutCache(LayoutCache &&)                 = delete;
+    LayoutCache &operator=(const LayoutCache &) = delete;
+    LayoutCache &operator=(LayoutCache &&)      = delete;
+
+    ~LayoutCache();
+
+    /**
+     * @brief write the layout of a formatter set to a file
+     * @details The file is written to a temporary file in the same directory that replaces path afterwards.
+     * @param path layout cache file (created or replaced)
+     * @param set formatters
+     *
+     * @exception std::invalid_argument a formatter was not created by MemoryFormatter::get_formatter or the formatters
+     *                                  have different base addresses
+     * @exception std::system_error failed to write the file
+     */
+    static void write(const std::string &path, const FormatterSet &set);
+
+    /**
+     * @brief get number of entries
+     * @return number of entries
+     */
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    /**
+     * @brief get the memory access semantics of the stored set
+     * @return memory access semantics
+     */
+    [[nodiscard]] memory_access get_access() const { return access; }
+
+    /**
+     * @brief get entry
+     * @param i entry index
+     * @return entry (the name is valid as long as the cache exists)
+     *
+     * @exception std::out_of_range i is out of range
+     * @exception std::runtime_error the entry is corrupt
+     */
+    [[nodiscard]] Entry entry(std::size_t i) const;
+
+    /**
+     * @brief create the formatter of an entry
+     * @details The formatter is interned (see MemoryFormatter::get_formatter): entries that shared an instance share
+     *          it again.
+     * @param i entry index
+     * @param base_addr memory base address
+     * @return formatter
+     *
+     * @exception std::out_of_range i is out of range
+     * @exception std::runtime_error the entry is corrupt
+     */
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> formatter(std::size_t i, void *base_addr) const;
+
+    /**
+     * @brief create the formatters of all entries
+     * @details Entries that shared a formatter instance share the created instance. The set uses the stored memory
+     *          access semantics.
+     * @param base_addr memory base address
+     * @return formatter set (same order and names as the set that was written)
+     *
+     * @exception std::runtime_error an entry is corrupt
+     */
+    [[nodiscard]] FormatterSet create(void *base_addr) const;
+};
+
+}  // namespace memformat
+
+#endif
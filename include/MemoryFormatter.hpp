@@ -6,8 +6,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
 namespace memformat {
 
@@ -54,6 +59,8 @@ enum class format : std::size_t {
     SIGNED,    //*< signed decimal
     UNSIGNED,  //*< unsigned decimal
     FLOAT,     //*< floating point (only allowed for 32 and 64 bit word size)
+    LABEL,     //*< label text of an integer value (only enum and bitmask formatters, see SymbolicFormatter.hpp)
+    STRING,    //*< character field (only string formatters, see StringFormatter.hpp)
 };
 
 /**
@@ -68,20 +75,202 @@ enum class wordsize : std::size_t {
 };
 
 
+/**
+ * @brief memory access semantics of the formatters
+ */
+enum class memory_access : std::size_t {
+    VOLATILE,  //*< volatile loads (default, every value is read exactly once, no tearing guarantees)
+
+    /**
+     * @brief plain loads
+     * @details for private memory that is not modified while it is formatted (e.g. snapshots). The compiler can
+     *          combine and vectorize the loads.
+     */
+    PLAIN,
+
+    /**
+     * @brief relaxed atomic loads
+     * @details aligned values are read tear-free (values at unaligned addresses are read with volatile loads)
+     */
+    RELAXED,
+
+    /**
+     * @brief acquire atomic loads
+     * @details like RELAXED, but memory operations after the load are not reordered before it (values at unaligned
+     *          addresses are read with volatile loads followed by an acquire fence)
+     */
+    ACQUIRE,
+};
+
+/**
+ * @brief maximum number of characters that are written by MemoryFormatter::format_to
+ * @details worst case is a 64 bit float in fixed notation (sign, 309 integer digits, decimal point and 6 decimals)
+ */
+constexpr std::size_t MAX_STRING_LENGTH = 317;
+
+/**
+ * @brief typed memory value
+ * @details bool: word size BIT_1, std::int64_t: format SIGNED, double: format FLOAT,
+ *          std::uint64_t: formats UNSIGNED, BIN, OCT and HEX
+ */
+using Value = std::variant<bool, std::int64_t, std::uint64_t, double>;
+
+class MemoryFormatter;
+
+/**
+ * @brief deleter for formatters that were created in a memory resource
+ */
+struct FormatterDeleter {
+    std::pmr::memory_resource *resource  = nullptr;  //*< memory resource the formatter was created in
+    std::size_t                size      = 0;        //*< size of the formatter object
+    std::size_t                alignment = 0;        //*< alignment of the formatter object
+
+    /**
+     * @brief destroy formatter and return its memory to the memory resource
+     * @param formatter formatter
+     */
+    void operator()(MemoryFormatter *formatter) const;
+};
+
+//* formatter that was created in a memory resource (see MemoryFormatter::get_formatter)
+using FormatterHandle = std::unique_ptr<MemoryFormatter, FormatterDeleter>;
+
+/**
+ * @brief formatted memory value in an inline buffer
+ * @details returned by MemoryFormatter::result. The buffer is large enough for every word size and format, no memory
+ *          is allocated.
+ */
+class FormatResult {
+private:
+    char        buffer[MAX_STRING_LENGTH];  //*< formatted value (not null terminated)
+    std::size_t length = 0;                 //*< number of characters
+
+    friend class MemoryFormatter;
+
+    FormatResult() = default;
+
+public:
+    /**
+     * @brief get formatted value
+     * @return pointer to the first character (not null terminated)
+     */
+    [[nodiscard]] const char *data() const { return buffer; }
+
+    /**
+     * @brief get number of characters
+     * @return number of characters
+     */
+    [[nodiscard]] std::size_t size() const { return length; }
+
+    /**
+     * @brief get iterator to the first character
+     * @return iterator
+     */
+    [[nodiscard]] const char *begin() const { return buffer; }
+
+    /**
+     * @brief get iterator behind the last character
+     * @return iterator
+     */
+    [[nodiscard]] const char *end() const { return buffer + length; }
+
+    /**
+     * @brief get formatted value as string view (valid as long as the FormatResult exists)
+     * @return string view
+     */
+    [[nodiscard]] std::string_view view() const { return {buffer, length}; }
+
+    /**
+     * @brief implicit conversion to std::string_view
+     * @return string view (valid as long as the FormatResult exists)
+     */
+    operator std::string_view() const { return view(); }  // NOLINT
+
+    /**
+     * @brief copy formatted value to a std::string
+     * @return formatted value
+     */
+    [[nodiscard]] std::string str() const { return {buffer, length}; }
+
+    /**
+     * @brief compare with a string
+     * @param other string
+     * @return true if equal
+     */
+    bool operator==(std::string_view other) const { return view() == other; }
+
+    /**
+     * @brief compare with a string
+     * @param other string
+     * @return true if not equal
+     */
+    bool operator!=(std::string_view other) const { return view() != other; }
+};
+
 /**
  * @brief abstract memory formatter class
  */
 class MemoryFormatter {
 protected:
-    volatile void *const base_address;  //*< base memory address
-    const std::size_t    offset;        //*< memory offset
+    volatile void *const base_address;   //*< base memory address
+    const std::size_t    offset;         //*< memory offset
+    const wordsize       word_size;      //*< word size of the formatted value
+    const format         output_format;  //*< output format
+    const endianness     endian;         //*< endianness of the formatted value
 
     /**
      * @brief construct MemoryFormatter
      * @param base_address base memory address
      * @param offset memory offset
+     * @param w word size
+     * @param f output format
+     * @param e endianness
      */
-    MemoryFormatter(volatile void *base_address, std::size_t offset) : base_address(base_address), offset(offset) {}
+    MemoryFormatter(volatile void *base_address, std::size_t offset, wordsize w, format f, endianness e)
+        : base_address(base_address), offset(offset), word_size(w), output_format(f), endian(e) {}
+
+    /**
+     * @brief write formatted memory value to dest
+     * @details the default implementation copies the result of string() and only supports the own base address.
+     *          Derived classes override this to format without temporary objects.
+     * @param base base memory address the value is read from (instead of base_address)
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @param access memory access semantics
+     * @return pointer behind the last written character
+     *
+     * @exception std::logic_error base differs from base_address and the formatter does not support relocation
+     */
+    virtual char *format_value(volatile void *base, char *dest, memory_access access) const;
+
+    /**
+     * @brief read memory value
+     * @details the default implementation throws std::logic_error
+     * @param base base memory address the value is read from
+     * @param access memory access semantics
+     * @return value in host endianness (zero extended to 64 bit, bit value for BIT_1)
+     */
+    virtual std::uint64_t raw_value(volatile void *base, memory_access access) const;
+
+    /**
+     * @brief format the memory value at the own base address into a std::string
+     * @details Uses format_to: the output does not depend on the global locale, no stream objects are created and the
+     *          call is recorded by the instrumentation counters.
+     *          Used by the string() implementations of the built-in formatters.
+     * @return formatted memory value
+     */
+    [[nodiscard]] std::string format_string() const;
+
+private:
+#ifdef MEMFORMAT_INSTRUMENTATION
+    /**
+     * @brief call format_value and record the call in the instrumentation counters
+     * @param base base memory address the value is read from
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @param access memory access semantics
+     * @return pointer behind the last written character
+     */
+    char *instrumented_format_value(volatile void *base, char *dest, memory_access access) const;
+#endif
 
 public:
     MemoryFormatter(const MemoryFormatter &)            = delete;
@@ -103,8 +292,186 @@ public:
      */
     [[nodiscard]] virtual std::size_t max_offset() const = 0;
 
+    /**
+     * @brief write formatted memory value to a character buffer
+     * @details the output is identical to string(), but no memory is allocated. The output is not null terminated.
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @return pointer behind the last written character
+     */
+    char *format_to(char *dest) const { return format_to(base_address, dest); }
+
+    /**
+     * @brief write formatted memory value of another memory region to a character buffer
+     * @details The value is read at the offset of the formatter relative to base instead of the base address of the
+     *          formatter. This allows to apply the same formatter to multiple memory regions with an identical layout
+     *          (e.g. double buffers or remapped shared memory) without constructing new formatters.
+     *          The memory access semantics are chosen by the caller (usually the access of the FormatterSet, see
+     *          FormatterSet::set_access). The formatter itself is immutable and can be shared.
+     * @param base base memory address the value is read from
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @param access memory access semantics
+     * @return pointer behind the last written character
+     */
+    char *format_to(volatile void *base, char *dest, memory_access access = memory_access::VOLATILE) const {
+#ifdef MEMFORMAT_INSTRUMENTATION
+        return instrumented_format_value(base, dest, access);
+#else
+        return format_value(base, dest, access);
+#endif
+    }
+
+    /**
+     * @brief format memory into an inline buffer
+     * @details the output is identical to string(), but no memory is allocated
+     * @return formatted memory value
+     */
+    [[nodiscard]] FormatResult result() const { return result(base_address); }
+
+    /**
+     * @brief format memory of another memory region into an inline buffer
+     * @param base base memory address the value is read from (see format_to)
+     * @param access memory access semantics
+     * @return formatted memory value
+     */
+    [[nodiscard]] FormatResult result(volatile void *base, memory_access access = memory_access::VOLATILE) const {
+        FormatResult r;
+        r.length = static_cast<std::size_t>(format_to(base, r.buffer, access) - r.buffer);
+        return r;
+    }
+
+    /**
+     * @brief append formatted memory value to a string
+     * @details no memory is allocated if out has sufficient capacity
+     * @param out output string
+     */
+    void append_to(std::string &out) const { append_to(base_address, out); }
+
+    /**
+     * @brief append formatted memory value of another memory region to a string
+     * @param base base memory address the value is read from (see format_to)
+     * @param out output string
+     * @param access memory access semantics
+     */
+    void append_to(volatile void *base, std::string &out, memory_access access = memory_access::VOLATILE) const;
+
+    /**
+     * @brief read memory value without formatting it
+     * @return value in host endianness (zero extended to 64 bit, bit value for BIT_1)
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    [[nodiscard]] std::uint64_t raw() const { return raw_value(base_address, memory_access::VOLATILE); }
+
+    /**
+     * @brief read memory value of another memory region without formatting it
+     * @param base base memory address the value is read from (see format_to)
+     * @param access memory access semantics
+     * @return value in host endianness (zero extended to 64 bit, bit value for BIT_1)
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    [[nodiscard]] std::uint64_t raw(volatile void *base, memory_access access = memory_access::VOLATILE) const {
+        return raw_value(base, access);
+    }
+
+    /**
+     * @brief read typed memory value
+     * @details the type depends on word size and format (see memformat::Value)
+     * @return value
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    [[nodiscard]] Value value() const { return value(base_address); }
+
+    /**
+     * @brief read typed memory value of another memory region
+     * @param base base memory address the value is read from (see format_to)
+     * @param access memory access semantics
+     * @return value
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    [[nodiscard]] Value value(volatile void *base, memory_access access = memory_access::VOLATILE) const;
+
+    /**
+     * @brief read memory value and convert it to an arithmetic type
+     * @tparam T arithmetic type (the conversion is a static_cast of the typed value)
+     * @return value
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    template <typename T>
+    [[nodiscard]] T value() const {
+        return value<T>(base_address);
+    }
+
+    /**
+     * @brief read memory value of another memory region and convert it to an arithmetic type
+     * @tparam T arithmetic type (the conversion is a static_cast of the typed value)
+     * @param base base memory address the value is read from (see format_to)
+     * @param access memory access semantics
+     * @return value
+     *
+     * @exception std::logic_error formatter does not provide raw values
+     */
+    template <typename T>
+    [[nodiscard]] T value(volatile void *base, memory_access access = memory_access::VOLATILE) const {
+        static_assert(std::is_arithmetic_v<T>);
+        return std::visit([](auto v) { return static_cast<T>(v); }, value(base, access));
+    }
+
+    /**
+     * @brief create a formatter with the same configuration at another memory address
+     * @details The default implementation returns the built-in formatter with the same word size, format, endianness
+     *          and bit index (interned, see get_formatter). Formatters with additional configuration (e.g. labels)
+     *          override this.
+     * @param base base memory address of the new formatter
+     * @param offset memory offset of the new formatter
+     * @return formatter
+     */
+    [[nodiscard]] virtual std::shared_ptr<MemoryFormatter> relocate(void *base, std::size_t offset) const;
+
+    /**
+     * @brief get base memory address
+     * @return base memory address
+     */
+    [[nodiscard]] volatile void *get_base_address() const { return base_address; }
+
+    /**
+     * @brief get memory offset of the formatted value
+     * @return memory offset
+     */
+    [[nodiscard]] std::size_t get_offset() const { return offset; }
+
+    /**
+     * @brief get word size of the formatted value
+     * @return word size
+     */
+    [[nodiscard]] wordsize get_wordsize() const { return word_size; }
+
+    /**
+     * @brief get output format
+     * @return output format (always format::BIN for word size BIT_1)
+     */
+    [[nodiscard]] format get_format() const { return output_format; }
+
+    /**
+     * @brief get endianness of the formatted value
+     * @return endianness (always endianness::HOST for word size BIT_1 and BIT_8)
+     */
+    [[nodiscard]] endianness get_endianness() const { return endian; }
+
+    /**
+     * @brief get bit index
+     * @return bit index [0..7] (always 0 for word sizes other than BIT_1)
+     */
+    [[nodiscard]] virtual std::size_t get_bit_index() const { return 0; }
+
     /**
      * @brief get memory formatter instance
+     * @details The instance is interned in FormatterPool::global(): identical arguments return the same instance as
+     *          long as it is in use. Formatters are immutable, sharing them is safe. Use the memory resource overloads
+     *          to create separate instances.
      * @param base_addr memory base address
      * @param addr_string string that is parsed as address
      *      word size 1: "<memory offset>.<bit index>" (regex: "^(0x)?[0-9]+\.[0-7]$")
@@ -123,6 +490,65 @@ public:
                                                                         wordsize           w,
                                                                         format             f = format::BIN,
                                                                         endianness         e = endianness::HOST);
+
+    /**
+     * @brief get memory formatter instance
+     * @details interned, see get_formatter(void *, const std::string &, wordsize, format, endianness)
+     * @param base_addr memory base address
+     * @param offset memory offset
+     * @param w word size \see memformat::wordsize
+     * @param f format \see memformat::format
+     *      value is ignored if wordsize is BIT_1
+     * @param e endianness \see memformat::endianness
+     * @param bit_index bit index (only relevant for w == BIT_1)
+     * @return std::shared_pointer that holds an MemoryFormatter instance
+     *
+     * @exception std::invalid_argument: invalid combination of word size, format and endianness
+     * @exception std::out_of_range: bit index out of range (only relevant for w == BIT_1)
+     */
+    [[nodiscard]] static std::shared_ptr<MemoryFormatter> get_formatter(void       *base_addr,
+                                                                        std::size_t offset,
+                                                                        wordsize    w,
+                                                                        format      f         = format::BIN,
+                                                                        endianness  e         = endianness::HOST,
+                                                                        std::size_t bit_index = 0);
+
+    /**
+     * @brief create memory formatter in a memory resource
+     * @details The formatter is constructed in memory that is allocated from resource (e.g. a
+     *          std::pmr::monotonic_buffer_resource to place many formatters in contiguous memory) instead of a separate
+     *          heap allocation with a reference count. The resource must outlive the returned handle.
+     *
+     *          see get_formatter for a description of the other arguments
+     * @param resource memory resource
+     * @return unique handle that holds the MemoryFormatter instance
+     *
+     * @exception std::invalid_argument: address string is invalid
+     * @exception std::out_of_range: bit index out of range (only relevant for w == BIT_1)
+     */
+    [[nodiscard]] static FormatterHandle get_formatter(std::pmr::memory_resource &resource,
+                                                       void                      *base_addr,
+                                                       const std::string         &addr_string,
+                                                       wordsize                   w,
+                                                       format                     f = format::BIN,
+                                                       endianness                 e = endianness::HOST);
+
+    /**
+     * @brief create memory formatter in a memory resource
+     * @details see get_formatter
+     * @param resource memory resource (must outlive the returned handle)
+     * @return unique handle that holds the MemoryFormatter instance
+     *
+     * @exception std::invalid_argument: invalid combination of word size, format and endianness
+     * @exception std::out_of_range: bit index out of range (only relevant for w == BIT_1)
+     */
+    [[nodiscard]] static FormatterHandle get_formatter(std::pmr::memory_resource &resource,
+                                                       void                      *base_addr,
+                                                       std::size_t                offset,
+                                                       wordsize                   w,
+                                                       format                     f         = format::BIN,
+                                                       endianness                 e         = endianness::HOST,
+                                                       std::size_t                bit_index = 0);
 };
 
 }  // namespace memformat
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+/*
+ * Implementation details of the memory formatters (conversion, memory access and number formatting).
+ * The header is part of the public include directory: it allows header-only code like StaticLayout to inline the same
+ * helpers as the formatters. The content is not part of the stable API.
+ */
+
+#include "MemoryFormatter.hpp"
+#include "endian.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace memformat::detail {
+
+/**
+ * @brief get number of bytes of a word size
+ * @param w word size
+ * @return number of bytes (1 for BIT_1)
+ */
+constexpr std::size_t word_bytes(wordsize w) {
+    switch (w) {
+        case wordsize::BIT_1:
+        case wordsize::BIT_8: return 1;
+        case wordsize::BIT_16: return 2;
+        case wordsize::BIT_32: return 4;
+        case wordsize::BIT_64: return 8;
+    }
+    return 0;
+}
+
+/**
+ * @brief write value as binary number with a fixed number of digits (same output as std::bitset<Bits>)
+ * @tparam Bits number of digits
+ * @tparam T unsigned integer type
+ * @param dest output buffer (at least Bits characters)
+ * @param value value to write
+ * @return pointer behind the last written character
+ */
+template <std::size_t Bits, typename T>
+inline char *bin_to_chars(char *dest, T value) {
+    static_assert(std::is_unsigned_v<T>);
+    static_assert(Bits <= sizeof(T) * 8);
+
+    for (std::size_t i = Bits; i > 0; --i) {
+        dest[i - 1] = static_cast<char>('0' + (value & 0x1));
+        value       = static_cast<T>(value >> 1);
+    }
+    return dest + Bits;
+}
+
+/**
+ * @brief write integer value with the given base (lowercase digits, no prefix)
+ * @tparam T integer type
+ * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+ * @param value value to write
+ * @param base number base
+ * @return pointer behind the last written character
+ */
+template <typename T>
+inline char *int_to_chars(char *dest, T value, int base = 10) {
+    static_assert(std::is_integral_v<T>);
+    return std::to_chars(dest, dest + MAX_STRING_LENGTH, value, base).ptr;
+}
+
+/**
+ * @brief write floating point value in fixed notation with 6 decimals (same output as std::to_string)
+ * @tparam T floating point type
+ * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+ * @param value value to write
+ * @return pointer behind the last written character
+ */
+template <typename T>
+inline char *float_to_chars(char *dest, T value) {
+    static_assert(std::is_floating_point_v<T>);
+    return std::to_chars(dest, dest + MAX_STRING_LENGTH, value, std::chars_format::fixed, 6).ptr;
+}
+
+/**
+ * @brief swap the 16 bit halves of every 32 bit word
+ * @tparam T unsigned integer type (32 or 64 bit)
+ * @param value value
+ * @return value with swapped halves
+ */
+template <typename T>
+constexpr T swap_words16(T value) {
+    static_assert(std::is_unsigned_v<T> && sizeof(T) >= 4);
+    constexpr auto MASK = static_cast<T>(0x0000FFFF0000FFFFULL);
+    return static_cast<T>(((value & MASK) << 16) | ((value >> 16) & MASK));
+}
+
+/**
+ * @brief swap the 32 bit halves of a 64 bit word
+ * @param value value
+ * @return value with swapped halves
+ */
+constexpr std::uint64_t swap_words32(std::uint64_t value) { return (value << 32) | (value >> 32); }
+
+/**
+ * @brief convert raw memory value to a host value
+ * @details Same conversion as the memory formatters. The conversion is its own inverse (it converts host values to
+ *          the memory representation as well).
+ * @tparam T unsigned integer type
+ * @tparam E endianness of the memory value
+ * @param raw value as read from memory
+ * @return host value
+ */
+template <typename T, endianness E>
+inline T convert(T raw) {
+    static_assert(std::is_unsigned_v<T>);
+    static_assert(E == endianness::HOST || sizeof(T) >= 2);
+    static_assert((E != endianness::BIG_SWAP16 && E != endianness::LITTLE_SWAP16) || sizeof(T) >= 4);
+    static_assert((E != endianness::BIG_SWAP32 && E != endianness::LITTLE_SWAP32) || sizeof(T) >= 8);
+
+    if constexpr (E == endianness::HOST) return raw;
+    else if constexpr (E == endianness::BIG) return ::endian::big_to_host(raw);
+    else if constexpr (E == endianness::LITTLE) return ::endian::little_to_host(raw);
+    else if constexpr (E == endianness::BIG_SWAP16) return swap_words16(::endian::big_to_host(raw));
+    else if constexpr (E == endianness::LITTLE_SWAP16) return swap_words16(::endian::little_to_host(raw));
+    else if constexpr (E == endianness::BIG_SWAP32) return swap_words32(::endian::big_to_host(raw));
+    else return swap_words32(::endian::little_to_host(raw));
+}
+
+/**
+ * @brief read memory value (no alignment requirements)
+ * @tparam T unsigned integer type
+ * @tparam E endianness of the memory value
+ * @param src memory
+ * @return host value
+ */
+template <typename T, endianness E>
+inline T decode(const void *src) {
+    T raw;
+    std::memcpy(&raw, src, sizeof(T));
+    return convert<T, E>(raw);
+}
+
+/**
+ * @brief call a function with the endianness as compile time constant
+ * @details only endianness values that are valid for the word size are passed, others are ignored
+ * @tparam T unsigned integer type
+ * @tparam F function type
+ * @param e endianness
+ * @param f function (called as f(std::integral_constant<endianness, E>()))
+ * @return false if the endianness is not valid for the word size
+ */
+template <typename T, typename F>
+inline bool with_endianness(endianness e, F &&f) {
+    using E = endianness;
+    switch (e) {
+        case E::HOST: f(std::integral_constant<E, E::HOST>()); return true;
+        case E::BIG:
+            if constexpr (sizeof(T) >= 2) f(std::integral_constant<E, E::BIG>());
+            return sizeof(T) >= 2;
+        case E::LITTLE:
+            if constexpr (sizeof(T) >= 2) f(std::integral_constant<E, E::LITTLE>());
+            return sizeof(T) >= 2;
+        case E::BIG_SWAP16:
+            if constexpr (sizeof(T) >= 4) f(std::integral_constant<E, E::BIG_SWAP16>());
+            return sizeof(T) >= 4;
+        case E::LITTLE_SWAP16:
+            if constexpr (sizeof(T) >= 4) f(std::integral_constant<E, E::LITTLE_SWAP16>());
+            return sizeof(T) >= 4;
+        case E::BIG_SWAP32:
+            if constexpr (sizeof(T) >= 8) f(std::integral_constant<E, E::BIG_SWAP32>());
+            return sizeof(T) >= 8;
+        case E::LITTLE_SWAP32:
+            if constexpr (sizeof(T) >= 8) f(std::integral_constant<E, E::LITTLE_SWAP32>());
+            return sizeof(T) >= 8;
+    }
+    return false;
+}
+
+/**
+ * @brief check whether an address is suitably aligned for a native load
+ * @tparam T unsigned integer type
+ * @param address address
+ * @return true if the address is a multiple of alignof(T)
+ */
+template <typename T>
+constexpr bool is_aligned(std::uintptr_t address) {
+    return (address & (alignof(T) - 1)) == 0;
+}
+
+/**
+ * @brief read a value with a single native load
+ * @tparam T unsigned integer type
+ * @param src address of the value (must be aligned, see is_aligned)
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load_aligned(const volatile void *src) {
+    static_assert(std::is_unsigned_v<T>);
+    return *static_cast<const volatile T *>(src);
+}
+
+/**
+ * @brief read a value from an address without alignment requirements
+ * @details Volatile memory can not be copied with memcpy: the value is assembled from single byte loads (in memory
+ *          order), which is well-defined for any address.
+ * @tparam T unsigned integer type
+ * @param src address of the value
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load_unaligned(const volatile void *src) {
+    static_assert(std::is_unsigned_v<T>);
+
+    const auto   *bytes = static_cast<const volatile unsigned char *>(src);
+    unsigned char buffer[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+        buffer[i] = bytes[i];
+
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief read a value using the aligned or the unaligned load path
+ * @tparam T unsigned integer type
+ * @param base base memory address
+ * @param offset memory offset
+ * @param aligned base + offset is aligned (see is_aligned)
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load(volatile void *base, std::size_t offset, bool aligned) {
+    const volatile void *src = static_cast<volatile std::uint8_t *>(base) + offset;
+    return aligned ? load_aligned<T>(src) : load_unaligned<T>(src);
+}
+
+/**
+ * @brief read a value (the load path is selected by the alignment of the address)
+ * @tparam T unsigned integer type
+ * @param base base memory address
+ * @param offset memory offset
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load(volatile void *base, std::size_t offset) {
+    return load<T>(base, offset, is_aligned<T>(reinterpret_cast<std::uintptr_t>(base) + offset));
+}
+
+/**
+ * @brief read a value with plain loads
+ * @details the compiler can combine the loads (only allowed for memory that is not modified concurrently)
+ * @tparam T unsigned integer type
+ * @param src address of the value
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load_plain(const volatile void *src) {
+    T value;
+    std::memcpy(&value, const_cast<const void *>(src), sizeof(T));
+    return value;
+}
+
+/**
+ * @brief read a value with an atomic load
+ * @tparam T unsigned integer type
+ * @tparam Acquire acquire semantics (otherwise relaxed)
+ * @param src address of the value (must be aligned, see is_aligned)
+ * @return value (memory byte order)
+ */
+template <typename T, bool Acquire>
+inline T load_atomic(const volatile void *src) {
+#if defined(__GNUC__)
+    return __atomic_load_n(static_cast<const volatile T *>(src), Acquire ? __ATOMIC_ACQUIRE : __ATOMIC_RELAXED);
+#else
+    return load_aligned<T>(src);
+#endif
+}
+
+/**
+ * @brief read a value with the given memory access semantics
+ * @details atomic loads require an aligned address, unaligned values are read with volatile loads
+ * @tparam T unsigned integer type
+ * @param base base memory address
+ * @param offset memory offset
+ * @param aligned base + offset is aligned (see is_aligned)
+ * @param access memory access semantics
+ * @return value (memory byte order)
+ */
+template <typename T>
+inline T load(volatile void *base, std::size_t offset, bool aligned, memory_access access) {
+    const volatile void *src = static_cast<volatile std::uint8_t *>(base) + offset;
+
+    switch (access) {
+        case memory_access::PLAIN: return load_plain<T>(src);
+        case memory_access::RELAXED:
+            if (aligned) return load_atomic<T, false>(src);
+            break;
+        case memory_access::ACQUIRE: {
+            if (aligned) return load_atomic<T, true>(src);
+
+            // unaligned values can not be loaded atomically: the fence orders the following memory operations
+            const T value = load_unaligned<T>(src);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return value;
+        }
+        case memory_access::VOLATILE: break;
+    }
+
+    return aligned ? load_aligned<T>(src) : load_unaligned<T>(src);
+}
+
+}  // namespace memformat::detail
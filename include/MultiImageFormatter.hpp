@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief applies the layout of a formatter set to many memory images
+ * @details The layout (offsets, word sizes, formats and endianness) is taken from the formatter set once. It is then
+ *          applied to any number of memory images with the same layout as the memory of the set, e.g. the memory
+ *          images of identical devices. Each image is identified by the base address that replaces the common base
+ *          address of the formatters. No formatters are constructed per image: the memory required for the layout does
+ *          not depend on the number of images.
+ */
+class MultiImageFormatter {
+public:
+    /**
+     * @brief iteration order
+     */
+    enum class order {
+        IMAGE_MAJOR,   //*< all values of an image before the next image (sequential memory access per image)
+        LAYOUT_MAJOR,  //*< a value of all images before the next value (the same formatter for consecutive calls)
+    };
+
+    /**
+     * @brief callback that receives the formatted values
+     * @details arguments: image index, value index (same order as the formatter set), formatted value (only valid
+     *          during the call)
+     */
+    using Callback = std::function<void(std::size_t, std::size_t, std::string_view)>;
+
+private:
+    std::vector<std::shared_ptr<MemoryFormatter>> formatters;  //*< formatters in the order of the set
+    std::size_t                                   image_size;  //*< size of the memory region of the set
+    memory_access                                 access;      //*< memory access semantics of the set
+
+    //* index of the first entry with the same formatter instance (see FormatterSet::duplicates)
+    std::vector<std::size_t> first;
+
+    //* output slot of the entries with a shared formatter instance (NO_SLOT: the instance is not shared)
+    std::vector<std::size_t> slots;
+
+    //* number of output slots
+    std::size_t slot_count = 0;
+
+    //* slot of an entry whose formatter instance is not shared
+    static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+public:
+    /**
+     * @brief construct MultiImageFormatter
+     * @param set formatters that define the layout (the set can be destroyed afterwards)
+     *
+     * @exception std::invalid_argument the formatters have different base addresses
+     */
+    explicit MultiImageFormatter(const FormatterSet &set);
+
+    /**
+     * @brief format all values of multiple memory images
+     * @details If threads is greater than 1, the images are split into contiguous chunks that are formatted in
+     *          parallel. The callback is then called concurrently (but never concurrently for the same image).
+     *          The chosen iteration order applies within each chunk.
+     *          Every formatter instance formats a value of an image once: the callback receives the same output for
+     *          entries that share the instance (see FormatterSet::duplicates).
+     * @param images base addresses of the memory images (replace the base address of the formatters)
+     * @param count number of images
+     * @param callback function that is called for each formatted value
+     * @param o iteration order
+     * @param threads number of threads (0: number of hardware threads)
+     *
+     * @exception std::invalid_argument callback is empty
+     * @exception any exception that was thrown by the callback (the remaining values of the chunk are skipped)
+     */
+    void format(volatile void *const *images,
+                std::size_t           count,
+                const Callback       &callback,
+                order                 o       = order::IMAGE_MAJOR,
+                unsigned              threads = 1) const;
+
+    /**
+     * @brief format all values of multiple memory images
+     * @details see format(volatile void *const *, std::size_t, const Callback &, order, unsigned)
+     * @param images base addresses of the memory images
+     * @param callback function that is called for each formatted value
+     * @param o iteration order
+     * @param threads number of threads (0: number of hardware threads)
+     */
+    void format(const std::vector<volatile void *> &images,
+                const Callback                     &callback,
+                order                               o       = order::IMAGE_MAJOR,
+                unsigned                            threads = 1) const {
+        format(images.data(), images.size(), callback, o, threads);
+    }
+
+    /**
+     * @brief get formatter
+     * @param index value index
+     * @return formatter
+     */
+    [[nodiscard]] const MemoryFormatter &operator[](std::size_t index) const { return *formatters[index]; }
+
+    /**
+     * @brief get number of values per image
+     * @return number of values
+     */
+    [[nodiscard]] std::size_t size() const { return formatters.size(); }
+
+    /**
+     * @brief get size of a memory image
+     * @return size in bytes (size of the memory region of the formatter set, see FormatterSet::region)
+     */
+    [[nodiscard]] std::size_t get_image_size() const { return image_size; }
+
+private:
+    /**
+     * @brief format all values of a contiguous range of images
+     * @param images base addresses of the memory images
+     * @param first_image index of the first image
+     * @param last_image index behind the last image
+     * @param callback function that is called for each formatted value
+     * @param o iteration order
+     */
+    void format_range(volatile void *const *images,
+                      std::size_t           first_image,
+                      std::size_t           last_image,
+                      const Callback       &callback,
+                      order                 o) const;
+};
+
+}  // namespace memformat
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief abstract output sink that writes all values of a formatter set into a single buffer
+ * @details All names are escaped once by the constructor.
+ *          The values are formatted directly into the output buffer without temporary strings.
+ *          Every formatter instance is formatted once per render call: entries that share an instance (see
+ *          FormatterSet::duplicates) copy the output of the first entry with that instance.
+ *
+ *          The sink can be applied to other memory regions with the same layout as the memory region of the formatter
+ *          set (see FormatterSet::region), e.g. the front and back buffer of a double buffer or remapped shared memory.
+ *          The base address that replaces the common base address of the formatters is either passed per call
+ *          (render_region) or bound atomically (bind). Binding is thread safe and can be done while another thread
+ *          renders.
+ */
+class OutputSink {
+protected:
+    //* formatters in output order
+    std::vector<std::shared_ptr<MemoryFormatter>> formatters;
+
+    //* memory access semantics (copied from the formatter set)
+    memory_access access;
+
+    //* index of the first entry with the same formatter instance (see FormatterSet::duplicates)
+    std::vector<std::size_t> first;
+
+    //* base address the values are read from (nullptr: base address of the formatters)
+    std::atomic<volatile void *> bound_base {nullptr};
+
+    //* output buffer that is reused by render()
+    std::string buffer;
+
+    /**
+     * @brief construct OutputSink
+     * @param set formatters to output (the set can be destroyed afterwards)
+     *
+     * @exception std::invalid_argument the formatters have different base addresses
+     */
+    explicit OutputSink(const FormatterSet &set);
+
+public:
+    OutputSink(const OutputSink &)            = delete;
+    OutputSink(OutputSink &&)                 = delete;
+    OutputSink &operator=(const OutputSink &) = delete;
+    OutputSink &operator=(OutputSink &&)      = delete;
+
+    virtual ~OutputSink() = default;
+
+    /**
+     * @brief format all values into the internal buffer
+     * @details the buffer is reused, no memory is allocated once it has grown to its final size
+     * @return output (valid until the next call of render() or the destruction of the sink)
+     */
+    const std::string &render();
+
+    /**
+     * @brief format all values of another memory region into the internal buffer
+     * @param base base address that replaces the base address of the formatters (nullptr: no replacement)
+     * @return output (valid until the next call of render() or the destruction of the sink)
+     */
+    const std::string &render_region(volatile void *base);
+
+    /**
+     * @brief format all values and append them to a string
+     * @details the values are read from the bound memory region
+     * @param out output string
+     */
+    void render_to(std::string &out) const { render_region_to(out, bound()); }
+
+    /**
+     * @brief format all values of a memory region and append them to a string
+     * @param out output string
+     * @param base base address that replaces the base address of the formatters (nullptr: no replacement)
+     */
+    virtual void render_region_to(std::string &out, volatile void *base) const = 0;
+
+    /**
+     * @brief set the memory region that is used by render() and render_to()
+     * @details The formatters are not reconstructed. The base address is replaced atomically, a render call that is
+     *          in progress on another thread completes with the previous base address.
+     *          The offsets of the formatters are applied to the new base address: the memory region that is read
+     *          starts at base + (FormatterSet::region().address - base address of the formatters).
+     * @param base base address that replaces the base address of the formatters (nullptr: no replacement)
+     */
+    void bind(volatile void *base) { bound_base.store(base, std::memory_order_release); }
+
+    /**
+     * @brief get the bound base address
+     * @return base address (nullptr: base address of the formatters)
+     */
+    [[nodiscard]] volatile void *bound() const { return bound_base.load(std::memory_order_acquire); }
+
+protected:
+    /**
+     * @brief get the base address that is passed to MemoryFormatter::format_to
+     * @param i formatter index
+     * @param base replacement base address (nullptr: base address of the formatter)
+     * @return base address
+     */
+    [[nodiscard]] volatile void *base_of(std::size_t i, volatile void *base) const {
+        return base ? base : formatters[i]->get_base_address();
+    }
+};
+
+/**
+ * @brief JSON object output: {"name1":value1,"name2":value2}
+ * @details Signed, unsigned, float and bit values are written as JSON numbers (non-finite floats as null).
+ *          Binary, octal and hexadecimal values are written as JSON strings. Labels (format::LABEL) and character
+ *          fields (format::STRING) are written as escaped JSON strings.
+ */
+class JsonObjectSink : public OutputSink {
+private:
+    std::vector<std::string> prefixes;  //*< escaped keys including separators
+
+public:
+    explicit JsonObjectSink(const FormatterSet &set);
+
+    void render_region_to(std::string &out, volatile void *base) const override;
+};
+
+/**
+ * @brief JSON array output: [value1,value2]
+ * @details values are written as described for JsonObjectSink
+ */
+class JsonArraySink : public OutputSink {
+public:
+    explicit JsonArraySink(const FormatterSet &set);
+
+    void render_region_to(std::string &out, volatile void *base) const override;
+};
+
+/**
+ * @brief CSV row output: value1,value2\n
+ * @details Names, labels (format::LABEL) and character fields (format::STRING) are quoted as specified by RFC 4180 if
+ *          required, other values never require quoting.
+ */
+class CsvRowSink : public OutputSink {
+private:
+    char        delimiter;   //*< field delimiter
+    std::string header_row;  //*< escaped header line
+
+public:
+    /**
+     * @brief construct CsvRowSink
+     * @param set formatters to output
+     * @param delimiter field delimiter
+     */
+    explicit CsvRowSink(const FormatterSet &set, char delimiter = ',');
+
+    void render_region_to(std::string &out, volatile void *base) const override;
+
+    /**
+     * @brief get header line (names of all values, terminated by a newline)
+     * @return header line
+     */
+    [[nodiscard]] const std::string &header() const { return header_row; }
+};
+
+/**
+ * @brief InfluxDB line protocol output: measurement[,tag=value...] field=value[,field=value...] [timestamp]\n
+ * @details Signed values are written with suffix 'i', unsigned values with suffix 'u', bits as boolean and float
+ *          values without suffix (non-finite floats are omitted). Binary, octal and hexadecimal values, labels
+ *          (format::LABEL) and character fields (format::STRING) are written as string fields (quotes and backslashes
+ *          escaped). Nothing is written if no field remains (all values are non-finite floats).
+ */
+class LineProtocolSink : public OutputSink {
+private:
+    std::string              line_prefix;     //*< escaped measurement and tags (including the trailing space)
+    std::vector<std::string> field_prefixes;  //*< escaped field keys including the '='
+
+public:
+    /**
+     * @brief construct LineProtocolSink
+     * @param set formatters to output (the names are used as field keys)
+     * @param measurement measurement name
+     * @param tags tag set (key, value)
+     *
+     * @exception std::invalid_argument measurement is empty, the set contains no formatters or the
+     *                                  formatters have different base addresses
+     */
+    LineProtocolSink(const FormatterSet                                     &set,
+                     const std::string                                      &measurement,
+                     const std::vector<std::pair<std::string, std::string>> &tags = {});
+
+    void render_region_to(std::string &out, volatile void *base) const override;
+
+    /**
+     * @brief format all values and append them to a string (with timestamp)
+     * @details the values are read from the bound memory region
+     * @param out output string
+     * @param timestamp timestamp (precision as configured in the database, usually nanoseconds)
+     */
+    void render_to(std::string &out, std::int64_t timestamp) const;
+
+    /**
+     * @brief format all values into the internal buffer (with timestamp)
+     * @param timestamp timestamp (precision as configured in the database, usually nanoseconds)
+     * @return output (valid until the next call of render() or the destruction of the sink)
+     */
+    const std::string &render(std::int64_t timestamp);
+
+    using OutputSink::render;
+    using OutputSink::render_to;
+};
+
+}  // namespace memformat
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_LINUX
+
+#    include "FormatterSet.hpp"
+#    include "ReadPlan.hpp"
+
+#    include <cstddef>
+#    include <sys/types.h>
+#    include <sys/uio.h>
+#    include <vector>
+
+namespace memformat {
+
+/**
+ * @brief formats the memory of another process
+ * @details The base addresses of the formatters are interpreted as addresses in the address space of the remote
+ *          process (they are never dereferenced locally). The memory ranges that are read by the formatters are
+ *          merged by a ReadPlan. read() copies all ranges into a local buffer with a single process_vm_readv call
+ *          (one call per IOV_MAX ranges). The formatters returned by formatters() read from the local buffer.
+ *
+ *          Reading the memory of another process requires ptrace access permission (see ptrace(2)).
+ */
+class ProcessReader {
+private:
+    pid_t pid;  //*< remote process
+
+    ReadPlan               plan;        //*< read ranges in the remote process
+    std::vector<std::byte> buffer;      //*< local copy of all ranges
+    std::vector<iovec>     local_iov;   //*< io vectors of the local buffer
+    std::vector<iovec>     remote_iov;  //*< io vectors of the remote ranges
+    FormatterSet           local_set;   //*< formatters that read from the local buffer
+
+public:
+    /**
+     * @brief construct ProcessReader
+     * @param pid remote process
+     * @param set formatters with remote base addresses (the set can be destroyed afterwards)
+     * @param max_gap maximum number of unused bytes between two values that are read by a single range
+     *                (see ReadPlan)
+     *
+     * @exception std::invalid_argument set is empty
+     */
+    ProcessReader(pid_t pid, const FormatterSet &set, std::size_t max_gap = 0);
+
+    ProcessReader(const ProcessReader &)            = delete;
+    ProcessReader(ProcessReader &&)                 = delete;
+    ProcessReader &operator=(const ProcessReader &) = delete;
+    ProcessReader &operator=(ProcessReader &&)      = delete;
+
+    ~ProcessReader() = default;
+
+    /**
+     * @brief copy the memory ranges of the remote process into the local buffer
+     *
+     * @exception std::system_error process_vm_readv failed or a range could not be read completely
+     */
+    void read();
+
+    /**
+     * @brief get formatters that read from the local buffer
+     * @return formatter set (same order and names as the set that was passed to the constructor)
+     */
+    [[nodiscard]] const FormatterSet &formatters() const { return local_set; }
+
+    /**
+     * @brief get the merged memory ranges
+     * @return memory ranges in the remote process (sorted by address)
+     */
+    [[nodiscard]] const std::vector<ReadPlan::Range> &ranges() const { return plan.ranges(); }
+
+    /**
+     * @brief get number of bytes that are copied by read()
+     * @return size of the local buffer
+     */
+    [[nodiscard]] std::size_t size() const { return buffer.size(); }
+
+    /**
+     * @brief get remote process
+     * @return process id
+     */
+    [[nodiscard]] pid_t get_pid() const { return pid; }
+};
+
+}  // namespace memformat
+
+#endif
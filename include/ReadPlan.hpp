@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief plan of contiguous read ranges that cover all values of a formatter set
+ * @details The bytes that are read by each formatter ([offset, max_offset()] relative to its base address) are
+ *          merged into a minimal list of contiguous ranges. Two ranges are merged if the gap between them is at most
+ *          max_gap bytes: a larger threshold results in fewer, larger copies (the gap bytes are copied as well).
+ *
+ *          The ranges are copied back-to-back into a local buffer of buffer_size() bytes (range i starts at
+ *          Range::buffer_offset). The plan does not read any memory itself, any copy backend can be used (memcpy,
+ *          pread, process_vm_readv, ...). bind() creates formatters that read from such a buffer.
+ */
+class ReadPlan {
+public:
+    /**
+     * @brief contiguous read range
+     */
+    struct Range {
+        std::uintptr_t address;        //*< address of the first byte (base address + offset of the formatters)
+        std::size_t    size;           //*< number of bytes
+        std::size_t    buffer_offset;  //*< position of the range in the local buffer
+    };
+
+private:
+    std::vector<Range>       plan_ranges;     //*< read ranges (sorted by address)
+    std::vector<std::size_t> value_offsets;   //*< position of the first byte of each value in the local buffer
+    std::size_t              total_size = 0;  //*< size of the local buffer
+    std::size_t              gap_size   = 0;  //*< number of bytes in the buffer that are not read by any formatter
+
+    //* copies of the formatters at offset 0 (relocated to the local buffer by bind, same order as the set)
+    //* (nullptr for entries that share the formatter instance of a previous entry)
+    std::vector<std::shared_ptr<MemoryFormatter>> prototypes;
+    std::vector<std::string>                      names;         //*< formatter names (same order as the set)
+    std::vector<std::size_t>                      duplicate_of;  //*< see FormatterSet::duplicates
+
+public:
+    /**
+     * @brief construct ReadPlan
+     * @param set formatters (the set can be destroyed afterwards)
+     * @param max_gap maximum number of unused bytes between two values that are read by a single range
+     */
+    explicit ReadPlan(const FormatterSet &set, std::size_t max_gap = 0);
+
+    /**
+     * @brief get read ranges
+     * @return ranges sorted by address
+     */
+    [[nodiscard]] const std::vector<Range> &ranges() const { return plan_ranges; }
+
+    /**
+     * @brief get size of the local buffer
+     * @return sum of all range sizes
+     */
+    [[nodiscard]] std::size_t buffer_size() const { return total_size; }
+
+    /**
+     * @brief get number of bytes that are copied, but not read by any formatter
+     * @return number of gap bytes
+     */
+    [[nodiscard]] std::size_t gap_bytes() const { return gap_size; }
+
+    /**
+     * @brief get position of a value in the local buffer
+     * @param index index of the formatter in the set
+     * @return offset of the first byte that is read by the formatter
+     */
+    [[nodiscard]] std::size_t buffer_offset(std::size_t index) const { return value_offsets[index]; }
+
+    /**
+     * @brief copy all ranges from local memory into a buffer (memcpy backend)
+     * @param buffer local buffer (at least buffer_size() bytes)
+     */
+    void copy(void *buffer) const;
+
+    /**
+     * @brief create formatters that read from a local buffer
+     * @details The formatters use plain loads (memory_access::PLAIN) and share the base address buffer (the set can
+     *          be passed to output sinks). Entries that share a formatter instance in the original set also share the
+     *          created formatter.
+     * @param buffer local buffer that is filled according to the plan (must outlive the created set)
+     * @return formatter set (same order and names as the set that was passed to the constructor)
+     */
+    [[nodiscard]] FormatterSet bind(void *buffer) const;
+};
+
+}  // namespace memformat
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_POSIX
+
+#    include "FormatterSet.hpp"
+
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+#    include <vector>
+
+namespace memformat {
+
+/**
+ * @brief records timestamped raw snapshots of the memory region of a formatter set to a file
+ * @details Instead of formatted text, the raw memory is stored. Each frame is stored as XOR delta against the previous
+ *          frame (only changed bytes are stored). Every keyframe_interval frames (and whenever the delta would be
+ *          larger than the frame) a complete copy of the memory region is stored as keyframe.
+ *
+ *          The recording can be formatted later with the same formatters using Replay.
+ *
+ *          The class is not thread safe.
+ */
+class Recorder {
+private:
+    int                  fd;                 //*< output file descriptor
+    FormatterSet::Region region;             //*< memory region that is recorded
+    std::size_t          keyframe_interval;  //*< maximum distance between two keyframes
+    std::size_t          buffer_size;        //*< output is written if the buffer exceeds this size
+
+    std::vector<std::byte> previous;  //*< previous frame
+    std::vector<std::byte> current;   //*< current frame (used by record without data)
+    std::vector<std::byte> buffer;    //*< encoded frames that are not yet written
+
+    std::uint64_t frame_count   = 0;  //*< number of recorded frames
+    std::uint64_t total_written = 0;  //*< number of bytes written to the file
+
+public:
+    /**
+     * @brief construct Recorder
+     * @param path output file (created or truncated)
+     * @param set formatters that define the recorded memory region
+     * @param keyframe_interval maximum distance between two keyframes (lower values allow faster random access)
+     * @param buffer_size encoded frames are written to the file if they exceed this size
+     *
+     * @exception std::invalid_argument set is empty, the formatters have different base addresses,
+     *                                  memory region is too large or keyframe_interval is invalid
+     * @exception std::system_error failed to create the file
+     */
+    Recorder(const std::string  &path,
+             const FormatterSet &set,
+             std::size_t         keyframe_interval = 256,
+             std::size_t         buffer_size       = 65536);
+
+    Recorder(const Recorder &)            = delete;
+    Recorder(Recorder &&)                 = delete;
+    Recorder &operator=(const Recorder &) = delete;
+    Recorder &operator=(Recorder &&)      = delete;
+
+    /**
+     * @brief destroy Recorder (writes the remaining frames and closes the file, errors are ignored)
+     */
+    ~Recorder();
+
+    /**
+     * @brief record the current content of the memory region
+     * @param timestamp timestamp of the frame
+     *
+     * @exception std::system_error write failed
+     */
+    void record(std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+    /**
+     * @brief record an existing copy of the memory region (e.g. Sampler::Frame or SampleRing::Sample)
+     * @param data copy of the memory region (region().size bytes)
+     * @param timestamp timestamp of the frame
+     *
+     * @exception std::system_error write failed
+     */
+    void record(const void *data, std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+    /**
+     * @brief write all buffered frames to the file
+     *
+     * @exception std::system_error write failed
+     */
+    void flush();
+
+    /**
+     * @brief get number of recorded frames
+     * @return number of frames
+     */
+    [[nodiscard]] std::uint64_t frames() const { return frame_count; }
+
+    /**
+     * @brief get size of the recording
+     * @return number of bytes (including buffered frames)
+     */
+    [[nodiscard]] std::uint64_t size() const { return total_written + buffer.size(); }
+
+private:
+    /**
+     * @brief encode a frame into the buffer
+     * @param data frame
+     * @param timestamp timestamp of the frame
+     */
+    void encode(const std::byte *data, std::chrono::system_clock::time_point timestamp);
+};
+
+}  // namespace memformat
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_POSIX
+
+#    include "FormatterSet.hpp"
+
+#    include <chrono>
+#    include <cstddef>
+#    include <cstdint>
+#    include <string>
+#    include <vector>
+
+namespace memformat {
+
+/**
+ * @brief reads a recording that was created by Recorder
+ * @details The file is memory mapped. Any frame can be decoded on demand and formatted with the formatters of the set
+ *          that was used to create the recording. Decoding starts at the closest preceding keyframe (or continues from
+ *          the previously loaded frame).
+ *
+ *          A truncated last frame (e.g. if the recorder was not terminated properly) is ignored.
+ *
+ *          The class is not thread safe.
+ */
+class Replay {
+public:
+    /**
+     * @brief recorded frame
+     */
+    struct FrameInfo {
+        std::uint64_t                         sequence;   //*< frame number
+        std::chrono::system_clock::time_point timestamp;  //*< time of the snapshot
+    };
+
+private:
+    struct Index {
+        std::size_t offset;    //*< file offset of the record
+        std::size_t keyframe;  //*< index of the keyframe the frame depends on
+    };
+
+    const std::byte *file      = nullptr;  //*< mapped file
+    std::size_t      file_size = 0;        //*< size of the mapped file
+
+    std::size_t            region_size;  //*< size of the recorded memory region
+    std::vector<Index>     index;        //*< frame index
+    std::vector<FrameInfo> infos;        //*< frame infos
+
+    std::vector<std::byte> frame;             //*< decoded frame
+    std::size_t            loaded;            //*< index of the decoded frame (size(): no frame decoded)
+    FormatterSet           frame_formatters;  //*< formatters that read from the decoded frame
+
+public:
+    /**
+     * @brief open recording
+     * @param path recording file
+     * @param set formatters of the recording (the set that was passed to the Recorder or an equivalent set with any
+     *            base address)
+     *
+     * @exception std::system_error failed to open or map the file
+     * @exception std::runtime_error file is not a valid recording
+     * @exception std::invalid_argument the memory region of the set does not match the recording
+     */
+    Replay(const std::string &path, const FormatterSet &set);
+
+    Replay(const Replay &)            = delete;
+    Replay(Replay &&)                 = delete;
+    Replay &operator=(const Replay &) = delete;
+    Replay &operator=(Replay &&)      = delete;
+
+    ~Replay();
+
+    /**
+     * @brief get number of frames
+     * @return number of frames
+     */
+    [[nodiscard]] std::size_t size() const { return infos.size(); }
+
+    /**
+     * @brief get frame info
+     * @param i frame index
+     * @return frame info
+     *
+     * @exception std::out_of_range i is out of range
+     */
+    [[nodiscard]] const FrameInfo &info(std::size_t i) const { return infos.at(i); }
+
+    /**
+     * @brief find the last frame that was recorded at or before the given time
+     * @param timestamp time
+     * @return frame index
+     *
+     * @exception std::out_of_range there is no frame at or before the given time
+     */
+    [[nodiscard]] std::size_t find(std::chrono::system_clock::time_point timestamp) const;
+
+    /**
+     * @brief decode a frame
+     * @param i frame index
+     * @return formatters that read from the decoded frame (valid until the next call of load)
+     *
+     * @exception std::out_of_range i is out of range
+     * @exception std::runtime_error the recording is corrupt
+     */
+    const FormatterSet &load(std::size_t i);
+
+    /**
+     * @brief get the formatters that read from the decoded frame
+     * @return formatter set (same order as the set that was passed to the constructor)
+     */
+    [[nodiscard]] const FormatterSet &formatters() const { return frame_formatters; }
+
+    /**
+     * @brief get the decoded frame
+     * @return copy of the memory region
+     */
+    [[nodiscard]] const void *data() const { return frame.data(); }
+};
+
+}  // namespace memformat
+
+#endif
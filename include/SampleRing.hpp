@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "FormatterSet.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief lock-free single producer single consumer ring buffer of raw memory samples
+ * @details The producer copies the memory region of a formatter set (see FormatterSet::region) with a single memcpy
+ *          into a preallocated slot. The consumer formats the samples later (possibly on another thread) directly in
+ *          their slots: the formatters of sample_set() read from the base address Sample::base(), e.g.
+ *          sink.render_region(sample.base()) for an output sink that is created from sample_set().
+ *
+ *          Exactly one thread may call the producer functions (capture, push) and exactly one thread may call the
+ *          consumer functions (front, pop, consume). If the ring is full, new samples are dropped.
+ */
+class SampleRing {
+public:
+    /**
+     * @brief raw memory sample
+     */
+    struct Sample {
+        std::uint64_t                         sequence;   //*< sample number (gaps indicate dropped samples)
+        std::chrono::system_clock::time_point timestamp;  //*< time of the capture
+        const void                           *data;       //*< copy of the memory region
+        std::size_t                           size;       //*< size of the memory region
+
+        /**
+         * @brief get the base address of the formatters of sample_set() for this sample
+         * @return base address (e.g. for OutputSink::render_region or MemoryFormatter::result)
+         */
+        [[nodiscard]] volatile void *base() const { return const_cast<void *>(data); }
+    };
+
+    //* consumer callback
+    using Consumer = std::function<void(const Sample &)>;
+
+private:
+    //* cache line size (used to prevent false sharing between producer and consumer)
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    FormatterSet::Region region;       //*< memory region that is captured
+    std::size_t          capacity;     //*< number of slots
+    std::size_t          slot_stride;  //*< distance between two slots (region size rounded up to the cache line size)
+
+    std::vector<std::byte>                             storage;     //*< slot memory
+    std::vector<std::uint64_t>                         sequences;   //*< sample number of each slot
+    std::vector<std::chrono::system_clock::time_point> timestamps;  //*< timestamp of each slot
+
+    FormatterSet samples;  //*< formatters relative to the start of a slot
+
+    //* state that is modified by the producer
+    struct alignas(CACHE_LINE) ProducerState {
+        std::atomic<std::size_t>   head {0};         //*< next slot to write
+        std::size_t                cached_tail = 0;  //*< last known value of tail
+        std::uint64_t              produced    = 0;  //*< number of samples (including dropped samples)
+        std::atomic<std::uint64_t> dropped {0};      //*< number of dropped samples
+    } producer_state;
+
+    //* state that is modified by the consumer
+    struct alignas(CACHE_LINE) ConsumerState {
+        std::atomic<std::size_t> tail {0};         //*< next slot to read
+        std::size_t              cached_head = 0;  //*< last known value of head
+        Sample                   front_sample {};  //*< sample returned by front()
+    } consumer_state;
+
+public:
+    /**
+     * @brief construct SampleRing
+     * @param set formatters that define the captured memory region
+     * @param capacity number of samples that can be stored
+     *
+     * @exception std::invalid_argument set is empty, the formatters have different base addresses or
+     *                                  capacity is 0
+     */
+    SampleRing(const FormatterSet &set, std::size_t capacity);
+
+    SampleRing(const SampleRing &)            = delete;
+    SampleRing(SampleRing &&)                 = delete;
+    SampleRing &operator=(const SampleRing &) = delete;
+    SampleRing &operator=(SampleRing &&)      = delete;
+
+    ~SampleRing() = default;
+
+    /**
+     * @brief copy the memory region into the next free slot
+     * @param timestamp timestamp of the sample
+     * @return false if the ring is full (the sample is dropped)
+     */
+    bool capture(std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+    /**
+     * @brief copy an existing copy of the memory region into the next free slot
+     * @param data copy of the memory region (region().size bytes)
+     * @param timestamp timestamp of the sample
+     * @return false if the ring is full (the sample is dropped)
+     */
+    bool push(const void *data, std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+    /**
+     * @brief get the oldest sample
+     * @return pointer to the sample (valid until pop is called) or nullptr if the ring is empty
+     */
+    [[nodiscard]] const Sample *front();
+
+    /**
+     * @brief remove the oldest sample
+     * @details must only be called if front() returned a sample
+     */
+    void pop();
+
+    /**
+     * @brief call a function for the available samples (oldest first) and remove them
+     * @param consumer function that is called for each sample
+     * @param max maximum number of samples
+     * @return number of consumed samples
+     */
+    std::size_t consume(const Consumer &consumer, std::size_t max = std::numeric_limits<std::size_t>::max());
+
+    /**
+     * @brief get the formatters of the samples
+     * @details The formatters read relative to the start of a slot (plain loads). Pass Sample::base() as base address
+     *          to format a sample in its slot without copying it, e.g. with OutputSink::render_region. Without a
+     *          replacement base address, the formatters read the first slot.
+     * @return formatter set (same order and names as the set that was passed to the constructor)
+     */
+    [[nodiscard]] const FormatterSet &sample_set() const { return samples; }
+
+    /**
+     * @brief get the captured memory region
+     * @return memory region
+     */
+    [[nodiscard]] const FormatterSet::Region &get_region() const { return region; }
+
+    /**
+     * @brief get number of slots
+     * @return capacity
+     */
+    [[nodiscard]] std::size_t get_capacity() const { return capacity; }
+
+    /**
+     * @brief get number of stored samples
+     * @return number of samples (approximation if called concurrently)
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief get number of samples that were dropped because the ring was full
+     * @return number of dropped samples
+     */
+    [[nodiscard]] std::uint64_t dropped_samples() const {
+        return producer_state.dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief reserve the next free slot
+     * @return slot memory or nullptr if the ring is full
+     */
+    std::byte *producer_slot();
+
+    /**
+     * @brief publish the reserved slot
+     * @param timestamp timestamp of the sample
+     */
+    void producer_commit(std::chrono::system_clock::time_point timestamp);
+};
+
+}  // namespace memformat
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_POSIX
+
+#    include "FormatterSet.hpp"
+#    include "SampleRing.hpp"
+
+#    include <atomic>
+#    include <chrono>
+#    include <cstdint>
+#    include <exception>
+#    include <functional>
+#    include <future>
+#    include <thread>
+#    include <vector>
+
+namespace memformat {
+
+/**
+ * @brief periodically copies the memory region of a formatter set on a dedicated thread
+ * @details Every cycle the memory region of the formatter set (see FormatterSet::region) is copied with a single
+ *          memcpy into a snapshot buffer. The callback receives the raw snapshot and can format it using
+ *          snapshot_set(), a copy of the formatter set that reads from the snapshot buffer.
+ *
+ *          Alternatively, the samples can be captured directly into a SampleRing to format them on another thread.
+ *
+ *          The cycles are scheduled with absolute deadlines (clock_nanosleep, CLOCK_MONOTONIC). If a cycle takes
+ *          longer than the period, the missed deadlines are skipped and counted.
+ */
+class Sampler {
+public:
+    /**
+     * @brief sampled frame
+     */
+    struct Frame {
+        std::uint64_t                         sequence;   //*< cycle number (starts with 0)
+        std::chrono::system_clock::time_point timestamp;  //*< time of the snapshot
+        const void                           *data;       //*< snapshot of the memory region
+        std::size_t                           size;       //*< size of the snapshot
+    };
+
+    /**
+     * @brief sampler statistics
+     * @details all times are in nanoseconds
+     */
+    struct Statistics {
+        std::uint64_t cycles           = 0;  //*< number of completed cycles
+        std::uint64_t missed_deadlines = 0;  //*< number of skipped cycles
+        std::int64_t  latency_last     = 0;  //*< wake up latency of the last cycle (deadline to snapshot)
+        std::int64_t  latency_max      = 0;  //*< maximum wake up latency
+        std::int64_t  latency_mean     = 0;  //*< mean wake up latency
+        std::int64_t  duration_last    = 0;  //*< duration (snapshot and callback) of the last cycle
+        std::int64_t  duration_max     = 0;  //*< maximum cycle duration
+        std::int64_t  duration_mean    = 0;  //*< mean cycle duration
+    };
+
+    //* callback that is called every cycle on the sampler thread
+    using Callback = std::function<void(const Frame &)>;
+
+private:
+    FormatterSet::Region     region;               //*< memory region that is sampled
+    std::vector<std::byte>   snapshot;             //*< snapshot buffer
+    FormatterSet             snapshot_formatters;  //*< formatter set that reads from the snapshot
+    std::chrono::nanoseconds period;               //*< sampling period
+    Callback                 callback;             //*< frame callback
+    int                      cpu;                  //*< cpu the thread is pinned to (-1: no pinning)
+    SampleRing              *ring = nullptr;       //*< ring buffer the samples are captured into (optional)
+
+    std::thread        thread;
+    std::atomic_bool   running {false};
+    std::exception_ptr callback_exception;
+
+    std::atomic<std::uint64_t> cycles {0};
+    std::atomic<std::uint64_t> missed_deadlines {0};
+    std::atomic<std::int64_t>  latency_last {0};
+    std::atomic<std::int64_t>  latency_max {0};
+    std::atomic<std::int64_t>  latency_sum {0};
+    std::atomic<std::int64_t>  duration_last {0};
+    std::atomic<std::int64_t>  duration_max {0};
+    std::atomic<std::int64_t>  duration_sum {0};
+
+public:
+    /**
+     * @brief construct Sampler
+     * @param set formatters that define the sampled memory region
+     * @param period sampling period
+     * @param callback function that is called every cycle (called on the sampler thread)
+     * @param cpu cpu to pin the sampler thread to (-1: no pinning, only supported on Linux)
+     *
+     * @exception std::invalid_argument set is empty, the formatters have different base addresses,
+     *                                  period is not positive or callback is empty
+     */
+    Sampler(const FormatterSet &set, std::chrono::nanoseconds period, Callback callback, int cpu = -1);
+
+    /**
+     * @brief construct Sampler that captures into a ring buffer
+     * @details Every cycle the memory region of the ring is copied directly into the next free slot of the ring
+     *          (SampleRing::capture). The sampler thread is the producer of the ring.
+     * @param ring ring buffer (must outlive the sampler)
+     * @param period sampling period
+     * @param cpu cpu to pin the sampler thread to (-1: no pinning, only supported on Linux)
+     *
+     * @exception std::invalid_argument period is not positive
+     */
+    Sampler(SampleRing &ring, std::chrono::nanoseconds period, int cpu = -1);
+
+    Sampler(const Sampler &)            = delete;
+    Sampler(Sampler &&)                 = delete;
+    Sampler &operator=(const Sampler &) = delete;
+    Sampler &operator=(Sampler &&)      = delete;
+
+    /**
+     * @brief destroy Sampler (stops the sampler thread)
+     */
+    ~Sampler();
+
+    /**
+     * @brief start the sampler thread
+     * @details returns after the thread was pinned to the requested cpu (no cycle is executed before)
+     *
+     * @exception std::logic_error sampler is already running
+     * @exception std::system_error failed to pin the thread to the requested cpu
+     */
+    void start();
+
+    /**
+     * @brief stop the sampler thread
+     * @details waits for the current cycle to complete
+     *
+     * @exception any exception that was thrown by the callback (sampling stops after the callback throws)
+     */
+    void stop();
+
+    /**
+     * @brief check whether the sampler thread is running
+     * @return true if the sampler is running
+     */
+    [[nodiscard]] bool is_running() const { return running; }
+
+    /**
+     * @brief get formatter set that reads from the snapshot buffer
+     * @details Empty if the sampler captures into a ring buffer.
+     *          The formatters can be used to create output sinks. The snapshot buffer is overwritten every cycle,
+     *          the formatted values are only consistent within the callback. Entries keep sharing their formatter
+     *          instances: the sinks format every instance once per cycle.
+     * @return formatter set (same order as the set that was passed to the constructor)
+     */
+    [[nodiscard]] const FormatterSet &snapshot_set() const { return snapshot_formatters; }
+
+    /**
+     * @brief get statistics
+     * @return statistics
+     */
+    [[nodiscard]] Statistics statistics() const;
+
+private:
+    /**
+     * @brief sampler thread function
+     * @details The thread is pinned to the requested cpu before the first cycle. If pinning fails, the function
+     *          returns without sampling.
+     * @param pinned receives 0 if the thread was pinned (or no pinning was requested), otherwise an error number
+     */
+    void run(std::promise<int> pinned);
+};
+
+}  // namespace memformat
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief options for the memory scan functions
+ */
+struct ScanOptions {
+    //* only offsets that are a multiple of alignment are reported (1: every byte offset)
+    std::size_t alignment = 1;
+
+    //* the scan stops after max_results matches
+    std::size_t max_results = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * @brief search a memory region for an unsigned integer value
+ * @details The value is converted to its memory representation (word size and endianness) once and searched with
+ *          SIMD byte compares (SSE2 if available).
+ * @param data memory region
+ * @param size size of the memory region in bytes
+ * @param w word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @param e endianness
+ * @param value searched value
+ * @param options scan options
+ * @return offsets (relative to data) of all matches in ascending order
+ *         (can be passed to MemoryFormatter::get_formatter with data as base address)
+ *
+ * @exception std::invalid_argument word size or endianness is invalid or alignment is 0
+ * @exception std::out_of_range value does not fit into the word size
+ */
+[[nodiscard]] std::vector<std::size_t> scan_unsigned(const void        *data,
+                                                     std::size_t        size,
+                                                     wordsize           w,
+                                                     endianness         e,
+                                                     std::uint64_t      value,
+                                                     const ScanOptions &options = {});
+
+/**
+ * @brief search a memory region for a signed integer value
+ * @details see scan_unsigned
+ *
+ * @exception std::invalid_argument word size or endianness is invalid or alignment is 0
+ * @exception std::out_of_range value does not fit into the word size
+ */
+[[nodiscard]] std::vector<std::size_t> scan_signed(const void        *data,
+                                                   std::size_t        size,
+                                                   wordsize           w,
+                                                   endianness         e,
+                                                   std::int64_t       value,
+                                                   const ScanOptions &options = {});
+
+/**
+ * @brief search a memory region for a floating point value
+ * @details The value is converted to float (BIT_32) or double (BIT_64). The bit patterns are compared (0.0 and -0.0
+ *          are different values, NaN is found if the bit pattern matches). See scan_unsigned.
+ *
+ * @exception std::invalid_argument word size (BIT_32 or BIT_64) or endianness is invalid or alignment is 0
+ */
+[[nodiscard]] std::vector<std::size_t> scan_float(const void        *data,
+                                                  std::size_t        size,
+                                                  wordsize           w,
+                                                  endianness         e,
+                                                  double             value,
+                                                  const ScanOptions &options = {});
+
+/**
+ * @brief search a memory region for values within a range
+ * @details Every (aligned) offset is decoded with a loop that is specialized for word size and endianness.
+ * @param data memory region
+ * @param size size of the memory region in bytes
+ * @param w word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @param e endianness
+ * @param f interpretation of the value (SIGNED, UNSIGNED or FLOAT)
+ * @param min smallest value
+ * @param max largest value
+ * @param options scan options
+ * @return offsets (relative to data) of all matches in ascending order
+ *
+ * @exception std::invalid_argument word size, endianness, format or range is invalid or alignment is 0
+ */
+[[nodiscard]] std::vector<std::size_t> scan_range(const void        *data,
+                                                  std::size_t        size,
+                                                  wordsize           w,
+                                                  endianness         e,
+                                                  format             f,
+                                                  double             min,
+                                                  double             max,
+                                                  const ScanOptions &options = {});
+
+}  // namespace memformat
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+#include "MemoryFormatterDetail.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace memformat {
+
+namespace detail {
+
+/**
+ * @brief unsigned integer type of a word size
+ * @tparam W word size
+ */
+template <wordsize W>
+using word_type = std::conditional_t<
+        W == wordsize::BIT_8,
+        std::uint8_t,
+        std::conditional_t<W == wordsize::BIT_16,
+                           std::uint16_t,
+                           std::conditional_t<W == wordsize::BIT_32, std::uint32_t, std::uint64_t>>>;
+
+/**
+ * @brief format a memory value with a combination of word size, format and endianness that is known at compile time
+ * @details Same output as the corresponding MemoryFormatter. Defined in the header: the conversion and the number
+ *          formatting are inlined into the caller.
+ * @tparam W word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @tparam F format
+ * @tparam E endianness (HOST for BIT_8)
+ * @param src address of the memory value
+ * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+ * @return pointer behind the last written character
+ */
+template <wordsize W, format F, endianness E>
+inline char *static_format(volatile void *src, char *dest) {
+    using T = word_type<W>;
+
+    const auto value = convert<T, E>(load<T>(src, 0));
+
+    if constexpr (F == format::BIN) return bin_to_chars<sizeof(T) * 8>(dest, value);
+    else if constexpr (F == format::OCT) return int_to_chars(dest, value, 8);
+    else if constexpr (F == format::HEX) return int_to_chars(dest, value, 16);
+    else if constexpr (F == format::UNSIGNED) return int_to_chars(dest, value);
+    else if constexpr (F == format::SIGNED) {
+        std::make_signed_t<T> signed_value;
+        std::memcpy(&signed_value, &value, sizeof(value));
+        return int_to_chars(dest, signed_value);
+    } else {
+        std::conditional_t<sizeof(T) == 4, float, double> float_value;
+        static_assert(sizeof(float_value) == sizeof(value));
+        std::memcpy(&float_value, &value, sizeof(value));
+        return float_to_chars(dest, float_value);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief memory value of a layout that is defined at compile time
+ * @details The same rules as for MemoryFormatter::get_formatter apply, but invalid combinations of word size, format,
+ *          endianness and bit index are compile errors. The format is ignored for BIT_1 and the endianness is ignored
+ *          for BIT_1 and BIT_8.
+ * @tparam Offset memory offset
+ * @tparam W word size
+ * @tparam F format
+ * @tparam E endianness
+ * @tparam BitIndex bit index (only relevant for BIT_1)
+ */
+template <std::size_t Offset,
+          wordsize    W,
+          format      F        = format::BIN,
+          endianness  E        = endianness::HOST,
+          std::size_t BitIndex = 0>
+struct StaticField {
+    static_assert(W != wordsize::BIT_1 || BitIndex < 8, "bit index out of range");
+    static_assert(W == wordsize::BIT_1 || BitIndex == 0, "bit index is only allowed for word size BIT_1");
+    static_assert(F != format::FLOAT || (W != wordsize::BIT_8 && W != wordsize::BIT_16),
+                  "format FLOAT is only allowed for 32 and 64 bit values");
+    static_assert(F != format::LABEL, "format LABEL requires a label table");
+    static_assert(F != format::STRING, "format STRING requires a field length");
+    static_assert(W != wordsize::BIT_16 || E == endianness::HOST || E == endianness::BIG || E == endianness::LITTLE,
+                  "endianness is not allowed for 16 bit values");
+    static_assert(W != wordsize::BIT_32 || (E != endianness::BIG_SWAP32 && E != endianness::LITTLE_SWAP32),
+                  "endianness is not allowed for 32 bit values");
+
+    static constexpr std::size_t offset        = Offset;                                             //*< offset
+    static constexpr wordsize    word_size     = W;                                                  //*< word size
+    static constexpr format      output_format = W == wordsize::BIT_1 ? format::BIN : F;             //*< format
+    static constexpr endianness  endian        = detail::word_bytes(W) == 1 ? endianness::HOST : E;  //*< endianness
+    static constexpr std::size_t bit_index     = BitIndex;                                           //*< bit index
+    static constexpr std::size_t max_offset    = Offset + detail::word_bytes(W) - 1;  //*< last byte that is read
+
+    /**
+     * @brief write formatted memory value to a character buffer
+     * @param base base memory address
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @return pointer behind the last written character
+     */
+    static char *format_to(volatile void *base, char *dest) {
+        auto *src = static_cast<volatile std::uint8_t *>(base) + Offset;
+        if constexpr (W == wordsize::BIT_1) {
+            *dest = static_cast<char>('0' + ((*src >> BitIndex) & 0x1));
+            return dest + 1;
+        } else {
+            return detail::static_format<W, output_format, endian>(src, dest);
+        }
+    }
+};
+
+/**
+ * @brief layout of memory values that is defined at compile time
+ * @details Alternative to a FormatterSet for layouts that are known at build time: no address strings are parsed, no
+ *          formatters are allocated and no virtual functions are called. The fields are formatted in declaration
+ *          order by a fully unrolled sequence of calls.
+ *
+ *          Example:
+ *          @code
+ *          using Layout = StaticLayout<StaticField<0x10, wordsize::BIT_32, format::FLOAT, endianness::BIG>,
+ *                                      StaticField<0x14, wordsize::BIT_16, format::HEX>>;
+ *          Layout::for_each(base, [](std::size_t index, std::string_view value) { ... });
+ *          @endcode
+ * @tparam Fields StaticField types
+ */
+template <typename... Fields>
+class StaticLayout {
+    static_assert(sizeof...(Fields) > 0, "layout must contain at least one field");
+
+public:
+    //* number of fields
+    static constexpr std::size_t size = sizeof...(Fields);
+
+    //* number of bytes that are read from the base address (offset of the last byte + 1)
+    static constexpr std::size_t required_size = std::max({Fields::max_offset...}) + 1;
+
+    //* field type
+    template <std::size_t I>
+    using field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    /**
+     * @brief write formatted memory value of a field to a character buffer
+     * @tparam I field index
+     * @param base base memory address
+     * @param dest output buffer (at least MAX_STRING_LENGTH characters)
+     * @return pointer behind the last written character
+     */
+    template <std::size_t I>
+    static char *format_to(volatile void *base, char *dest) {
+        return field<I>::format_to(base, dest);
+    }
+
+    /**
+     * @brief format all fields
+     * @tparam F function type
+     * @param base base memory address (at least required_size bytes)
+     * @param f function that is called for each field as f(std::size_t index, std::string_view value)
+     *          (the value is only valid during the call)
+     */
+    template <typename F>
+    static void for_each(volatile void *base, F &&f) {
+        for_each(base, f, std::make_index_sequence<size>());
+    }
+
+    /**
+     * @brief format all fields of a memory image
+     * @details The size of the image is checked at compile time.
+     * @tparam Image type of the memory image (e.g. a struct or an array)
+     * @tparam F function type
+     * @param image memory image
+     * @param f function that is called for each field as f(std::size_t index, std::string_view value)
+     */
+    template <typename Image, typename F>
+    static void for_each_in(Image &image, F &&f) {
+        static_assert(!std::is_pointer_v<Image>, "use for_each to format memory behind a pointer");
+        static_assert(sizeof(Image) >= required_size, "memory image is smaller than the layout");
+        for_each(const_cast<std::remove_cv_t<Image> *>(&image), f, std::make_index_sequence<size>());
+    }
+
+private:
+    /**
+     * @brief format all fields (unrolled)
+     * @tparam F function type
+     * @tparam I field indices
+     * @param base base memory address
+     * @param f function that is called for each field
+     */
+    template <typename F, std::size_t... I>
+    static void for_each(volatile void *base, F &f, std::index_sequence<I...>) {
+        char buffer[MAX_STRING_LENGTH];
+        (f(I, std::string_view(buffer, static_cast<std::size_t>(format_to<I>(base, buffer) - buffer))), ...);
+    }
+};
+
+}  // namespace memformat
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#ifdef OS_POSIX
+
+#    include "MemoryFormatter.hpp"
+
+#    include <cstddef>
+#    include <deque>
+#    include <memory>
+#    include <string_view>
+#    include <sys/uio.h>
+#    include <vector>
+
+namespace memformat {
+
+/**
+ * @brief buffered writer for formatted output
+ * @details The output is accumulated in page aligned buffers. flush() writes all pending buffers with a single
+ *          writev call (or a single io_uring submission if the library was built with IO_URING enabled and io_uring
+ *          is supported by the kernel).
+ *
+ *          The number of buffers is limited. If all buffers are in use, write() rejects the data (back-pressure)
+ *          instead of blocking. Use a file descriptor with O_NONBLOCK to ensure that flush() never blocks either
+ *          (not required for the io_uring backend).
+ *
+ *          The class is not thread safe.
+ */
+class StreamWriter {
+private:
+    struct Buffer {
+        char       *data;         //*< page aligned memory
+        std::size_t used    = 0;  //*< number of bytes that contain data
+        std::size_t written = 0;  //*< number of bytes that are already written to the file descriptor
+    };
+
+    struct IoUring;  //*< io_uring backend (only available if built with IO_URING)
+
+    int         fd;             //*< output file descriptor
+    std::size_t buffer_size;    //*< size of a single buffer (multiple of the page size)
+    std::size_t max_buffers;    //*< maximum number of buffers
+    std::size_t allocated = 0;  //*< number of allocated buffers
+
+    std::deque<Buffer>  buffers;       //*< buffers with data (the last one is filled by write)
+    std::vector<char *> free_buffers;  //*< allocated buffers that are currently not in use
+
+    bool               in_flight = false;  //*< an io_uring write operation is in progress
+    std::vector<iovec> iov;                //*< io vectors of the current write operation
+
+    std::unique_ptr<IoUring> uring;  //*< io_uring instance (nullptr: writev is used)
+
+    std::size_t total_written = 0;  //*< total number of bytes written to the file descriptor
+
+public:
+    /**
+     * @brief construct StreamWriter
+     * @param fd output file descriptor (not closed by the destructor)
+     * @param buffer_size size of a single buffer (rounded up to a multiple of the page size)
+     * @param max_buffers maximum number of buffers
+     *
+     * @exception std::invalid_argument max_buffers is 0
+     */
+    explicit StreamWriter(int fd, std::size_t buffer_size = 65536, std::size_t max_buffers = 16);
+
+    StreamWriter(const StreamWriter &)            = delete;
+    StreamWriter(StreamWriter &&)                 = delete;
+    StreamWriter &operator=(const StreamWriter &) = delete;
+    StreamWriter &operator=(StreamWriter &&)      = delete;
+
+    /**
+     * @brief destroy StreamWriter
+     * @details waits for io_uring operations in progress and tries to flush the remaining data (errors are ignored)
+     */
+    ~StreamWriter();
+
+    /**
+     * @brief append data to the buffers
+     * @param data data to append
+     * @return false if there is not enough buffer space (nothing is appended)
+     */
+    [[nodiscard]] bool write(std::string_view data);
+
+    /**
+     * @brief format memory value directly into the buffers
+     * @param formatter formatter
+     * @return false if there is not enough buffer space (nothing is appended)
+     */
+    [[nodiscard]] bool write(const MemoryFormatter &formatter);
+
+    /**
+     * @brief write pending data to the file descriptor
+     * @details Writes as much as possible with a single system call. Data that could not be written remains pending.
+     * @return number of bytes written (or completed for io_uring) by this call
+     *
+     * @exception std::system_error write failed
+     */
+    std::size_t flush();
+
+    /**
+     * @brief get number of bytes that are not yet written
+     * @return number of pending bytes
+     */
+    [[nodiscard]] std::size_t pending_bytes() const;
+
+    /**
+     * @brief get total number of bytes written to the file descriptor
+     * @return number of bytes written
+     */
+    [[nodiscard]] std::size_t bytes_written() const { return total_written; }
+
+    /**
+     * @brief check whether io_uring is used to write the data
+     * @return true if io_uring is used, false if writev is used
+     */
+    [[nodiscard]] bool uses_io_uring() const { return uring != nullptr; }
+
+private:
+    /**
+     * @brief get number of bytes that can be appended without exceeding the buffer limit
+     * @return free buffer space
+     */
+    [[nodiscard]] std::size_t free_space() const;
+
+    /**
+     * @brief make sure that the last buffer has at least n bytes of free space
+     * @param n number of bytes
+     * @return false if the buffer limit is reached
+     */
+    bool reserve_contiguous(std::size_t n);
+
+    /**
+     * @brief add a new buffer to the end of the buffer list
+     * @return false if the buffer limit is reached
+     */
+    bool push_buffer();
+
+    /**
+     * @brief mark written bytes as done and recycle buffers that are completely written
+     * @param n number of bytes
+     */
+    void consume(std::size_t n);
+
+    /**
+     * @brief collect io vectors for all pending data
+     */
+    void collect_iov();
+
+    /**
+     * @brief write pending data with a single writev call
+     * @return number of bytes written
+     */
+    std::size_t flush_writev();
+
+    /**
+     * @brief process the completion of the io_uring write operation in progress
+     * @param wait wait for the completion
+     * @return number of bytes written by the completed operation
+     */
+    std::size_t io_uring_complete(bool wait);
+
+    /**
+     * @brief submit pending data as a single io_uring write operation
+     */
+    void io_uring_submit_pending();
+};
+
+}  // namespace memformat
+
+#endif
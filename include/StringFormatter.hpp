@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace memformat {
+
+/**
+ * @brief end of the string in a fixed length character field
+ */
+enum class string_termination : std::size_t {
+    NUL,   //*< the string ends at the first null character
+    TRIM,  //*< all characters except trailing null characters and spaces
+    NONE   //*< all characters of the field
+};
+
+/**
+ * @brief create a formatter that writes a fixed length character field as string
+ * @details The field is read as a sequence of words of the word size w. The bytes of each word are reordered as for a
+ *          numeric value of endianness e and written from the most significant to the least significant byte.
+ *          Examples for the field "ABCD":
+ *              - BIT_8 (any endianness), BIT_16 BIG, BIT_32 BIG: memory "ABCD"
+ *              - BIT_16 LITTLE: memory "BADC" (every 16 bit word byte-swapped)
+ *              - BIT_32 LITTLE: memory "DCBA"
+ *              - BIT_32 BIG_SWAP16: memory "CDAB"
+ *              - BIT_32 LITTLE_SWAP16: memory "BADC"
+ *          endianness::HOST is the byte order of the host (LITTLE on little endian hosts).
+ *          The bytes are reordered with a vectorized byte shuffle (16 bytes per step) if the CPU supports SSSE3
+ *          (detected at runtime on x86, independent of the compiler flags).
+ *
+ *          Printable ASCII characters are written unchanged. If escape is true, other characters are written as \\xHH
+ *          and a backslash is written as \\\\. Otherwise, other characters are replaced by '.'.
+ *
+ *          get_format() returns format::STRING: output sinks write the value as (escaped) string. raw() and value() are
+ *          not supported (std::logic_error).
+ * @param base_addr memory base address
+ * @param offset memory offset
+ * @param length field length in bytes (multiple of the word size)
+ * @param w word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @param e endianness
+ * @param termination end of the string in the field
+ * @param escape escape non-printable characters (true) or replace them by '.' (false)
+ * @return formatter
+ *
+ * @exception std::invalid_argument word size BIT_1, invalid endianness for the word size, length is 0 or not a
+ *                                  multiple of the word size or the longest output exceeds MAX_STRING_LENGTH
+ *                                  (4 * length with escaping, length without escaping)
+ */
+[[nodiscard]] std::shared_ptr<MemoryFormatter>
+        get_string_formatter(void              *base_addr,
+                             std::size_t        offset,
+                             std::size_t        length,
+                             wordsize           w           = wordsize::BIT_8,
+                             endianness         e           = endianness::BIG,
+                             string_termination termination = string_termination::NUL,
+                             bool               escape      = true);
+
+}  // namespace memformat
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include "MemoryFormatter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace memformat {
+
+/**
+ * @brief compiled value to label table
+ * @details All labels are stored in a single string. If the values span a small range, they are looked up in a dense
+ *          array (index: value - smallest value). Sparse values are looked up in an open addressing hash table
+ *          (multiplicative hash, linear probing, at most half of the slots are used). Lookups do not allocate memory.
+ */
+class LabelTable {
+public:
+    //* value to label mapping
+    using Entries = std::vector<std::pair<std::uint64_t, std::string>>;
+
+private:
+    //* table slot
+    struct Slot {
+        std::uint64_t value  = 0;  //*< value (only used by the hash table)
+        std::uint32_t offset = 0;  //*< position of the label in text
+        std::uint32_t size   = 0;  //*< length of the label (0: empty slot)
+    };
+
+    std::string       text;               //*< all labels
+    std::vector<Slot> slots;              //*< dense array or hash table
+    std::uint64_t     min_value  = 0;     //*< smallest value (dense array)
+    bool              dense      = true;  //*< slots is a dense array
+    unsigned          hash_shift = 0;     //*< 64 - log2(number of slots) (hash table)
+    std::size_t       count      = 0;     //*< number of labels
+    std::size_t       max_length = 0;     //*< length of the longest label
+
+public:
+    /**
+     * @brief compile label table
+     * @param entries value to label mapping
+     *
+     * @exception std::invalid_argument duplicate value, empty label or label longer than MAX_STRING_LENGTH
+     */
+    explicit LabelTable(const Entries &entries);
+
+    /**
+     * @brief get the label of a value
+     * @param value value
+     * @return label (empty if the value has no label)
+     */
+    [[nodiscard]] std::string_view find(std::uint64_t value) const {
+        if (dense) {
+            const auto index = value - min_value;  // wraps around for values smaller than min_value
+            if (index >= slots.size()) return {};
+            const auto &slot = slots[index];
+            return {text.data() + slot.offset, slot.size};
+        }
+
+        const auto mask = slots.size() - 1;
+        for (auto index = hash(value);; index = (index + 1) & mask) {
+            const auto &slot = slots[index];
+            if (slot.size == 0) return {};
+            if (slot.value == value) return {text.data() + slot.offset, slot.size};
+        }
+    }
+
+    /**
+     * @brief get number of labels
+     * @return number of labels
+     */
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    /**
+     * @brief check whether the labels are stored in a dense array
+     * @return true: dense array, false: hash table
+     */
+    [[nodiscard]] bool is_dense() const { return dense; }
+
+    /**
+     * @brief get the length of the longest label
+     * @return label length
+     */
+    [[nodiscard]] std::size_t max_label_length() const { return max_length; }
+
+    /**
+     * @brief call a function for every label
+     * @tparam F function type (void(std::uint64_t value, std::string_view label))
+     * @param f function
+     */
+    template <typename F>
+    void for_each(F &&f) const {
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            const auto &slot = slots[i];
+            if (slot.size == 0) continue;
+            f(dense ? min_value + i : slot.value, std::string_view(text.data() + slot.offset, slot.size));
+        }
+    }
+
+private:
+    /**
+     * @brief get hash table index of a value
+     * @param value value
+     * @return slot index
+     */
+    [[nodiscard]] std::size_t hash(std::uint64_t value) const {
+        return static_cast<std::size_t>((value * 0x9E3779B97F4A7C15ULL) >> hash_shift);
+    }
+};
+
+/**
+ * @brief create a formatter that writes the label of the memory value
+ * @details The value is read as unsigned integer. Values without label are written as unsigned decimal number.
+ *          get_format() returns format::LABEL (raw() and value() return the numeric value).
+ * @param base_addr memory base address
+ * @param offset memory offset
+ * @param w word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @param e endianness
+ * @param labels label table (shared with relocated copies of the formatter)
+ * @return formatter
+ *
+ * @exception std::invalid_argument word size BIT_1, invalid endianness for the word size or labels is a nullptr
+ */
+[[nodiscard]] std::shared_ptr<MemoryFormatter> get_enum_formatter(void                             *base_addr,
+                                                                  std::size_t                       offset,
+                                                                  wordsize                          w,
+                                                                  endianness                        e,
+                                                                  std::shared_ptr<const LabelTable> labels);
+
+/**
+ * @brief create a formatter that writes the labels of the bits that are set in the memory value
+ * @details The labels of the set bits are written from the lowest to the highest bit, separated by separator.
+ *          Set bits without label are combined and written as hexadecimal number with the prefix 0x behind the
+ *          labels. If no bit is set, 0 is written.
+ *          get_format() returns format::LABEL (raw() and value() return the numeric value).
+ * @param base_addr memory base address
+ * @param offset memory offset
+ * @param w word size (BIT_8, BIT_16, BIT_32 or BIT_64)
+ * @param e endianness
+ * @param labels label table (every value must have exactly one bit set)
+ * @param separator separator between two labels
+ * @return formatter
+ *
+ * @exception std::invalid_argument word size BIT_1, invalid endianness for the word size, labels is a nullptr, a value
+ *                                  is not a single bit of the word size or the longest output exceeds MAX_STRING_LENGTH
+ */
+[[nodiscard]] std::shared_ptr<MemoryFormatter> get_bitmask_formatter(void                             *base_addr,
+                                                                     std::size_t                       offset,
+                                                                     wordsize                          w,
+                                                                     endianness                        e,
+                                                                     std::shared_ptr<const LabelTable> labels,
+                                                                     std::string_view                  separator = "|");
+
+}  // namespace memformat
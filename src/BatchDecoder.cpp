@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "BatchDecoder.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace memformat {
+
+/**
+ * @brief get value type of a formatter
+ * @param formatter formatter
+ * @return value type
+ *
+ * @exception std::invalid_argument the formatter writes a character field (format STRING)
+ */
+static BatchDecoder::value_type get_value_type(const MemoryFormatter &formatter) {
+    if (formatter.get_wordsize() == wordsize::BIT_1) return BatchDecoder::value_type::BIT;
+
+    switch (formatter.get_format()) {
+        case format::SIGNED: return BatchDecoder::value_type::SIGNED;
+        case format::FLOAT: return BatchDecoder::value_type::FLOAT;
+        case format::BIN:
+        case format::OCT:
+        case format::HEX:
+        case format::UNSIGNED:
+        case format::LABEL: return BatchDecoder::value_type::UNSIGNED;
+        case format::STRING: throw std::invalid_argument("character fields can not be decoded to numeric columns");
+    }
+
+    return BatchDecoder::value_type::UNSIGNED;
+}
+
+/**
+ * @brief decode a column
+ * @tparam T unsigned integer type of the memory value
+ * @tparam E endianness of the memory value
+ * @tparam Value type the memory value is interpreted as (T, signed T, float or double)
+ * @tparam Out output type
+ * @param src address of the value in the first image
+ * @param count number of images
+ * @param stride distance between two images
+ * @param out output array
+ */
+template <typename T, endianness E, typename Value, typename Out>
+static void decode_column(const std::byte *src, std::size_t count, std::size_t stride, Out *out) {
+    static_assert(sizeof(Value) == sizeof(T));
+    for (std::size_t i = 0; i < count; ++i) {
+        const T raw = detail::decode<T, E>(src + i * stride);
+        Value   value;
+        std::memcpy(&value, &raw, sizeof(value));
+        out[i] = static_cast<Out>(value);
+    }
+}
+
+/**
+ * @brief decode a column (dispatch of the value type)
+ * @tparam T unsigned integer type of the memory value
+ * @tparam E endianness of the memory value
+ * @tparam Out output type
+ * @param type value type
+ * @param src address of the value in the first image
+ * @param count number of images
+ * @param stride distance between two images
+ * @param out output array
+ */
+template <typename T, endianness E, typename Out>
+static void decode_column(BatchDecoder::value_type type,
+                          const std::byte         *src,
+                          std::size_t              count,
+                          std::size_t              stride,
+                          Out                     *out) {
+    using Float = std::conditional_t<sizeof(T) == 8, double, float>;
+
+    switch (type) {
+        case BatchDecoder::value_type::SIGNED:
+            decode_column<T, E, std::make_signed_t<T>>(src, count, stride, out);
+            break;
+        case BatchDecoder::value_type::FLOAT:
+            if constexpr (sizeof(T) >= 4) decode_column<T, E, Float>(src, count, stride, out);
+            break;
+        case BatchDecoder::value_type::BIT:
+        case BatchDecoder::value_type::UNSIGNED: decode_column<T, E, T>(src, count, stride, out); break;
+    }
+}
+
+/**
+ * @brief decode a column (dispatch of the endianness)
+ * @tparam T unsigned integer type of the memory value
+ * @tparam Out output type
+ * @param field field
+ * @param src address of the value in the first image
+ * @param count number of images
+ * @param stride distance between two images
+ * @param out output array
+ */
+template <typename T, typename Out>
+static void decode_column(const BatchDecoder::Field &field,
+                          const std::byte           *src,
+                          std::size_t                count,
+                          std::size_t                stride,
+                          Out                       *out) {
+    detail::with_endianness<T>(field.endian, [&](auto e) {
+        decode_column<T, decltype(e)::value>(field.type, src, count, stride, out);
+    });
+}
+
+BatchDecoder::BatchDecoder(const FormatterSet &set) {
+    const auto region = set.region();
+    const auto start  = reinterpret_cast<std::uintptr_t>(region.address);
+    image_size        = region.size;
+
+    layout.reserve(set.size());
+    for (const auto &entry : set) {
+        const auto &f       = *entry.formatter;
+        const auto  address = reinterpret_cast<std::uintptr_t>(f.get_base_address()) + f.get_offset();
+        layout.push_back({entry.name,
+                          address - start,
+                          f.get_wordsize(),
+                          f.get_endianness(),
+                          f.get_bit_index(),
+                          get_value_type(f)});
+    }
+}
+
+template <typename Out>
+void BatchDecoder::decode_field(std::size_t field,
+                                const void *images,
+                                std::size_t count,
+                                std::size_t stride,
+                                Out        *out) const {
+    if (stride < image_size) throw std::invalid_argument("stride is smaller than the image size");
+
+    const auto &f   = layout.at(field);
+    const auto *src = static_cast<const std::byte *>(images) + f.offset;
+
+    switch (f.word_size) {
+        case wordsize::BIT_1:
+            for (std::size_t i = 0; i < count; ++i)
+                out[i] = static_cast<Out>((std::to_integer<unsigned>(src[i * stride]) >> f.bit_index) & 0x1);
+            break;
+        case wordsize::BIT_8: decode_column<std::uint8_t>(f, src, count, stride, out); break;
+        case wordsize::BIT_16: decode_column<std::uint16_t>(f, src, count, stride, out); break;
+        case wordsize::BIT_32: decode_column<std::uint32_t>(f, src, count, stride, out); break;
+        case wordsize::BIT_64: decode_column<std::uint64_t>(f, src, count, stride, out); break;
+    }
+}
+
+void BatchDecoder::decode(std::size_t   field,
+                          const void   *images,
+                          std::size_t   count,
+                          std::size_t   stride,
+                          std::uint8_t *out) const {
+    decode_field(field, images, count, stride, out);
+}
+
+void BatchDecoder::decode(std::size_t   field,
+                          const void   *images,
+                          std::size_t   count,
+                          std::size_t   stride,
+                          std::int64_t *out) const {
+    decode_field(field, images, count, stride, out);
+}
+
+void BatchDecoder::decode(std::size_t    field,
+                          const void    *images,
+                          std::size_t    count,
+                          std::size_t    stride,
+                          std::uint64_t *out) const {
+    decode_field(field, images, count, stride, out);
+}
+
+void BatchDecoder::decode(std::size_t field,
+                          const void *images,
+                          std::size_t count,
+                          std::size_t stride,
+                          double     *out) const {
+    decode_field(field, images, count, stride, out);
+}
+
+std::vector<BatchDecoder::Column> BatchDecoder::decode_all(const void *images,
+                                                           std::size_t count,
+                                                           std::size_t stride) const {
+    std::vector<Column> columns;
+    columns.reserve(layout.size());
+
+    for (std::size_t i = 0; i < layout.size(); ++i) {
+        switch (layout[i].type) {
+            case value_type::BIT: columns.emplace_back(std::vector<std::uint8_t>(count)); break;
+            case value_type::SIGNED: columns.emplace_back(std::vector<std::int64_t>(count)); break;
+            case value_type::UNSIGNED: columns.emplace_back(std::vector<std::uint64_t>(count)); break;
+            case value_type::FLOAT: columns.emplace_back(std::vector<double>(count)); break;
+        }
+
+        std::visit([&](auto &column) { decode(i, images, count, stride, column.data()); }, columns.back());
+    }
+
+    return columns;
+}
+
+}  // namespace memformat
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatProgram.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace memformat {
+
+//* maximum number of integer digits of a double in fixed notation (plus sign and decimal point)
+static constexpr std::size_t FLOAT_INTEGER_CHARS = 1 + 309 + 1;
+
+/**
+ * @brief throw std::invalid_argument for an invalid template
+ * @param pattern template
+ * @param position position of the error in the template
+ * @param what error description
+ */
+[[noreturn]] static void template_error(std::string_view pattern, std::size_t position, const char *what) {
+    std::ostringstream error_msg;
+    error_msg << "Invalid format template '" << pattern << "' at position " << position << ": " << what;
+    throw std::invalid_argument(error_msg.str());
+}
+
+/**
+ * @brief get the operation of a conversion name
+ * @param name conversion name
+ * @param op output: operation
+ * @return false if the conversion name is unknown
+ */
+static bool parse_conversion(std::string_view name, FormatProgram::operation &op) {
+    using operation = FormatProgram::operation;
+
+    static constexpr struct {
+        std::string_view name;
+        operation        op;
+    } CONVERSIONS[] = {
+            {"name", operation::NAME},
+            {"value", operation::VALUE},
+            {"bin", operation::BIN},
+            {"oct", operation::OCT},
+            {"hex", operation::HEX},
+            {"HEX", operation::HEX_UPPER},
+            {"unsigned", operation::UNSIGNED},
+            {"signed", operation::SIGNED},
+            {"float", operation::FLOAT},
+    };
+
+    for (const auto &conversion : CONVERSIONS) {
+        if (conversion.name == name) {
+            op = conversion.op;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief parse a decimal number at the beginning of a string
+ * @param str string (the number is removed)
+ * @param value output: parsed number (unchanged if the string does not start with a digit)
+ * @param max maximum value
+ * @return false if the number is larger than max
+ */
+static bool parse_number(std::string_view &str, std::size_t &value, std::size_t max) {
+    std::size_t result = 0;
+    std::size_t i      = 0;
+    for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i) {
+        result = result * 10 + static_cast<std::size_t>(str[i] - '0');
+        if (result > max) return false;
+    }
+
+    if (i != 0) value = result;
+    str.remove_prefix(i);
+    return true;
+}
+
+/**
+ * @brief pad the output of an operation to the width of the operation
+ * @param start first character of the output
+ * @param end pointer behind the last character of the output
+ * @param op operation
+ * @return pointer behind the padded output
+ */
+static char *pad(char *start, char *end, const FormatProgram::Op &op) {
+    const auto length = static_cast<std::size_t>(end - start);
+    if (length >= op.width) return end;
+
+    const auto fill = op.width - length;
+    if (op.left_align) return std::fill_n(end, fill, ' ');
+
+    // zeros are inserted behind the sign
+    char *digits = start;
+    if (op.zero_pad && (*start == '-' || *start == '+')) ++digits;
+
+    std::memmove(digits + fill, digits, static_cast<std::size_t>(end - digits));
+    std::fill_n(digits, fill, op.zero_pad ? '0' : ' ');
+    return end + fill;
+}
+
+FormatProgram::FormatProgram(std::string_view pattern) {
+    std::size_t literal_start = 0;
+
+    // create a literal operation for the text behind the previous operation
+    auto flush_literal = [&]() {
+        if (literals.size() == literal_start) return;
+        Op op {operation::LITERAL};
+        op.literal_offset = literal_start;
+        op.literal_size   = literals.size() - literal_start;
+        program.push_back(op);
+        literal_start = literals.size();
+    };
+
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        const auto c = pattern[i];
+
+        if (c == '}') {
+            if (i + 1 == pattern.size() || pattern[i + 1] != '}') template_error(pattern, i, "unmatched '}'");
+            literals.push_back('}');
+            ++i;
+            continue;
+        }
+
+        if (c != '{') {
+            literals.push_back(c);
+            continue;
+        }
+
+        if (i + 1 < pattern.size() && pattern[i + 1] == '{') {
+            literals.push_back('{');
+            ++i;
+            continue;
+        }
+
+        const auto close = pattern.find('}', i + 1);
+        if (close == std::string_view::npos) template_error(pattern, i, "unmatched '{'");
+
+        const auto placeholder = pattern.substr(i + 1, close - i - 1);
+        const auto colon       = placeholder.find(':');
+
+        Op op {operation::LITERAL};
+        if (!parse_conversion(placeholder.substr(0, colon), op.type))
+            template_error(pattern, i + 1, "unknown conversion");
+
+        if (colon != std::string_view::npos) {
+            auto spec = placeholder.substr(colon + 1);
+            if (!spec.empty() && spec.front() == '-') {
+                op.left_align = true;
+                spec.remove_prefix(1);
+            }
+            if (!spec.empty() && spec.front() == '0') {
+                op.zero_pad = true;
+                spec.remove_prefix(1);
+            }
+            if (!parse_number(spec, op.width, MAX_WIDTH)) template_error(pattern, i + 1, "width too large");
+            if (!spec.empty() && spec.front() == '.') {
+                spec.remove_prefix(1);
+                if (spec.empty() || spec.front() < '0' || spec.front() > '9')
+                    template_error(pattern, i + 1, "missing precision");
+                if (!parse_number(spec, op.precision, MAX_PRECISION))
+                    template_error(pattern, i + 1, "precision too large");
+                if (op.type != operation::FLOAT)
+                    template_error(pattern, i + 1, "precision is only supported for the conversion float");
+            }
+            if (!spec.empty()) template_error(pattern, i + 1, "invalid format spec");
+            if (op.zero_pad && op.type == operation::NAME)
+                template_error(pattern, i + 1, "zero padding is not supported for the conversion name");
+        }
+
+        flush_literal();
+        program.push_back(op);
+        needs_raw = needs_raw || (op.type != operation::NAME && op.type != operation::VALUE);
+        i         = close;
+    }
+
+    flush_literal();
+}
+
+std::size_t FormatProgram::max_size(std::size_t name_length) const {
+    std::size_t size = 0;
+    for (const auto &op : program) {
+        std::size_t length = 0;
+        switch (op.type) {
+            case operation::LITERAL: length = op.literal_size; break;
+            case operation::NAME: length = name_length; break;
+            case operation::VALUE: length = MAX_STRING_LENGTH; break;
+            case operation::BIN: length = 64; break;
+            case operation::OCT: length = 22; break;
+            case operation::HEX:
+            case operation::HEX_UPPER: length = 16; break;
+            case operation::UNSIGNED:
+            case operation::SIGNED: length = 20; break;
+            case operation::FLOAT: length = FLOAT_INTEGER_CHARS + op.precision; break;
+        }
+        size += std::max(length, op.width);
+    }
+    return size;
+}
+
+char *FormatProgram::format_to(volatile void         *base,
+                               char                  *dest,
+                               const MemoryFormatter &formatter,
+                               std::string_view       name,
+                               memory_access          access) const {
+    // the memory value is read only once
+    const auto raw = needs_raw ? formatter.raw(base, access) : std::uint64_t {0};
+    const auto w   = formatter.get_wordsize();
+
+    for (const auto &op : program) {
+        if (op.type == operation::LITERAL) {
+            dest = std::copy_n(literals.data() + op.literal_offset, op.literal_size, dest);
+            continue;
+        }
+
+        char *const start = dest;
+        switch (op.type) {
+            case operation::LITERAL: break;
+            case operation::NAME: dest = std::copy(name.begin(), name.end(), dest); break;
+            case operation::VALUE: dest = formatter.format_to(base, dest, access); break;
+            case operation::BIN: {
+                const auto bits = w == wordsize::BIT_1 ? 1 : detail::word_bytes(w) * 8;
+                for (std::size_t i = 0; i < bits; ++i)
+                    dest[i] = static_cast<char>('0' + ((raw >> (bits - 1 - i)) & 0x1));
+                dest += bits;
+                break;
+            }
+            case operation::OCT: dest = detail::int_to_chars(dest, raw, 8); break;
+            case operation::HEX: dest = detail::int_to_chars(dest, raw, 16); break;
+            case operation::HEX_UPPER:
+                dest = detail::int_to_chars(dest, raw, 16);
+                for (char *p = start; p != dest; ++p)
+                    if (*p >= 'a') *p = static_cast<char>(*p - 'a' + 'A');
+                break;
+            case operation::UNSIGNED: dest = detail::int_to_chars(dest, raw); break;
+            case operation::SIGNED:
+                switch (w) {
+                    case wordsize::BIT_8: dest = detail::int_to_chars(dest, static_cast<std::int8_t>(raw)); break;
+                    case wordsize::BIT_16: dest = detail::int_to_chars(dest, static_cast<std::int16_t>(raw)); break;
+                    case wordsize::BIT_32: dest = detail::int_to_chars(dest, static_cast<std::int32_t>(raw)); break;
+                    case wordsize::BIT_1:
+                    case wordsize::BIT_64: dest = detail::int_to_chars(dest, static_cast<std::int64_t>(raw)); break;
+                }
+                break;
+            case operation::FLOAT: {
+                const auto last      = dest + FLOAT_INTEGER_CHARS + op.precision;
+                const auto precision = static_cast<int>(op.precision);
+                if (w == wordsize::BIT_32) {
+                    const auto raw32 = static_cast<std::uint32_t>(raw);
+                    float      value;
+                    std::memcpy(&value, &raw32, sizeof(value));
+                    dest = std::to_chars(dest, last, value, std::chars_format::fixed, precision).ptr;
+                } else if (w == wordsize::BIT_64) {
+                    double value;
+                    std::memcpy(&value, &raw, sizeof(value));
+                    dest = std::to_chars(dest, last, value, std::chars_format::fixed, precision).ptr;
+                } else {
+                    throw std::invalid_argument("the conversion float requires a 32 or 64 bit value");
+                }
+                break;
+            }
+        }
+
+        dest = pad(start, dest, op);
+    }
+
+    return dest;
+}
+
+void FormatProgram::append_to(std::string &out, const FormatterSet::Entry &entry, memory_access access) const {
+    const auto old_size = out.size();
+    out.resize(old_size + max_size(entry.name.size()));
+    const auto &f   = *entry.formatter;
+    const auto  end = format_to(f.get_base_address(), out.data() + old_size, f, entry.name, access);
+    out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+void FormatProgram::append_to(std::string &out, const FormatterSet &set) const {
+    for (const auto &entry : set) {
+        append_to(out, entry, set.get_access());
+        out.push_back('\n');
+    }
+}
+
+std::string FormatProgram::string(const FormatterSet::Entry &entry) const {
+    std::string result;
+    append_to(result, entry);
+    return result;
+}
+
+}  // namespace memformat
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterPool.hpp"
+
+#include "MemoryFormatterImpl.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace memformat {
+
+std::size_t FormatterPool::KeyHash::operator()(const Key &key) const {
+    // word size, format and endianness
+    const auto type = (static_cast<std::uint64_t>(key.w) << 16) | (static_cast<std::uint64_t>(key.f) << 8) |
+                      static_cast<std::uint64_t>(key.e);
+
+    const std::uint64_t fields[] = {key.base, key.offset, key.bit_index, type};
+
+    // multiplicative hash (the high bits are folded into the low bits that select the shard)
+    std::uint64_t hash = 0;
+    for (const auto field : fields)
+        hash = (hash ^ field) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
+
+namespace {
+
+/**
+ * @brief get the reader stripe of the calling thread
+ * @param stripes number of stripes
+ * @return stripe index
+ */
+std::size_t reader_stripe(std::size_t stripes) {
+    static std::atomic<std::size_t> next {0};
+    thread_local const std::size_t  stripe = next.fetch_add(1, std::memory_order_relaxed);
+    return stripe % stripes;
+}
+
+}  // namespace
+
+FormatterPool::Table::Table(std::size_t size) : mask(size - 1), slots(new std::atomic<Node *>[size]) {
+    for (std::size_t i = 0; i < size; ++i)
+        slots[i].store(nullptr, std::memory_order_relaxed);
+}
+
+FormatterPool::ReadGuard::ReadGuard(FormatterPool &pool)
+    : counter(pool.readers[reader_stripe(STRIPES)].active[pool.epoch.load() & 1]) {
+    counter.fetch_add(1);
+}
+
+FormatterPool::ReadGuard::~ReadGuard() { counter.fetch_sub(1); }
+
+FormatterPool::~FormatterPool() {
+    for (auto &shard : shards) {
+        auto *table = shard.table.load();
+        if (table) {
+            for (std::size_t i = 0; i <= table->mask; ++i)
+                delete table->slots[i].load();
+            delete table;
+        }
+        for (auto *node : shard.retired_nodes)
+            delete node;
+        for (auto *retired : shard.retired_tables)
+            delete retired;
+    }
+}
+
+std::shared_ptr<MemoryFormatter> FormatterPool::find(const Table *table, const Key &key, std::size_t hash) {
+    if (!table) return nullptr;
+
+    // the table always contains empty slots: the probing terminates
+    for (auto i = (hash / SHARDS) & table->mask;; i = (i + 1) & table->mask) {
+        const auto *node = table->slots[i].load();
+        if (!node) return nullptr;
+        if (node->key == key) return node->formatter.lock();
+    }
+}
+
+void FormatterPool::synchronize() {
+    std::lock_guard<std::mutex> lock(reclaim_mutex);
+
+    // lookups register with the counter of the parity they read: after the first flip no new lookup registers with
+    // the previous parity, the second flip waits for lookups that read the parity before the first flip
+    for (int flip = 0; flip < 2; ++flip) {
+        const auto previous = epoch.fetch_add(1) & 1;
+        for (auto &stripe : readers) {
+            while (stripe.active[previous].load() != 0)
+                std::this_thread::yield();
+        }
+    }
+}
+
+void FormatterPool::reclaim(Shard &shard) {
+    if (shard.retired_nodes.empty() && shard.retired_tables.empty()) return;
+
+    synchronize();
+
+    for (auto *node : shard.retired_nodes)
+        delete node;
+    for (auto *table : shard.retired_tables)
+        delete table;
+    shard.retired_nodes.clear();
+    shard.retired_tables.clear();
+}
+
+void FormatterPool::rebuild(Shard &shard, std::size_t extra) {
+    auto *old_table = shard.table.load();
+
+    std::size_t live = 0;
+    if (old_table) {
+        for (std::size_t i = 0; i <= old_table->mask; ++i) {
+            const auto *node = old_table->slots[i].load();
+            if (node && !node->formatter.expired()) ++live;
+        }
+    }
+
+    // at most a quarter of the new table is used after the rebuild
+    std::size_t size = MIN_SIZE;
+    while (size < (live + extra) * 4)
+        size *= 2;
+
+    auto table = std::make_unique<Table>(size);
+
+    // no allocation after the first modification
+    shard.retired_nodes.reserve(shard.retired_nodes.size() + shard.used);
+    shard.retired_tables.reserve(shard.retired_tables.size() + 1);
+
+    std::size_t used = 0;
+    if (old_table) {
+        for (std::size_t i = 0; i <= old_table->mask; ++i) {
+            auto *node = old_table->slots[i].load();
+            if (!node) continue;
+
+            // formatters never become valid again after they expired
+            if (node->formatter.expired()) {
+                shard.retired_nodes.push_back(node);
+                continue;
+            }
+
+            const auto hash = KeyHash()(node->key);
+            auto       j    = (hash / SHARDS) & table->mask;
+            while (table->slots[j].load(std::memory_order_relaxed))
+                j = (j + 1) & table->mask;
+            table->slots[j].store(node, std::memory_order_relaxed);
+            ++used;
+        }
+    }
+
+    shard.table.store(table.release());
+    shard.used = used;
+    if (old_table) shard.retired_tables.push_back(old_table);
+
+    reclaim(shard);
+}
+
+std::shared_ptr<MemoryFormatter> FormatterPool::get(
+        void *base_addr, std::size_t offset, wordsize w, format f, endianness e, std::size_t bit_index) {
+    // arguments that are ignored by get_formatter do not create separate formatters
+    Key key {reinterpret_cast<std::uintptr_t>(base_addr), offset, bit_index, w, f, e};
+    switch (w) {
+        case wordsize::BIT_1:
+            key.f = format::BIN;
+            key.e = endianness::HOST;
+            break;
+        case wordsize::BIT_8:
+            key.e         = endianness::HOST;
+            key.bit_index = 0;
+            break;
+        case wordsize::BIT_16:
+        case wordsize::BIT_32:
+        case wordsize::BIT_64: key.bit_index = 0; break;
+    }
+
+    const auto hash  = KeyHash()(key);
+    auto      &shard = shards[hash & (SHARDS - 1)];
+
+    // lock-free lookup
+    {
+        ReadGuard guard(*this);
+        if (auto formatter = find(shard.table.load(), key, hash)) return formatter;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // inserted by another thread while waiting for the lock (entries are only freed with the lock held)
+    if (auto formatter = find(shard.table.load(), key, hash)) return formatter;
+
+    auto formatter = detail::new_formatter(base_addr, offset, w, f, e, bit_index);
+    auto node      = std::make_unique<Node>(Node {key, formatter});
+
+    auto *table = shard.table.load();
+    if (!table || (shard.used + 1) * 2 > table->mask + 1) {
+        rebuild(shard, 1);
+        table = shard.table.load();
+    }
+
+    for (auto i = (hash / SHARDS) & table->mask;; i = (i + 1) & table->mask) {
+        auto *current = table->slots[i].load();
+        if (!current) {
+            table->slots[i].store(node.release());
+            ++shard.used;
+            break;
+        }
+
+        // expired entry of the key: replaced (lookups may still read the old entry)
+        if (current->key == key) {
+            shard.retired_nodes.push_back(current);
+            table->slots[i].store(node.release());
+            break;
+        }
+    }
+
+    if (shard.retired_nodes.size() >= std::max(shard.used, MIN_SIZE)) reclaim(shard);
+    return formatter;
+}
+
+std::shared_ptr<MemoryFormatter> FormatterPool::get(
+        void *base_addr, const std::string &addr_string, wordsize w, format f, endianness e) {
+    std::size_t offset    = 0;
+    std::size_t bit_index = 0;
+    detail::parse_address(addr_string, w, offset, bit_index);
+    return get(base_addr, offset, w, f, e, bit_index);
+}
+
+std::size_t FormatterPool::size() const {
+    std::size_t result = 0;
+    for (const auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto *table = shard.table.load();
+        if (!table) continue;
+        for (std::size_t i = 0; i <= table->mask; ++i) {
+            const auto *node = table->slots[i].load();
+            if (node && !node->formatter.expired()) ++result;
+        }
+    }
+    return result;
+}
+
+void FormatterPool::purge() {
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.table.load()) rebuild(shard, 0);
+    }
+}
+
+FormatterPool &FormatterPool::global() {
+    // never destroyed: formatters are also requested and released by destructors of static objects
+    static auto *const pool = new FormatterPool();
+    return *pool;
+}
+
+}  // namespace memformat
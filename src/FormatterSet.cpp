@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace memformat {
+
+void FormatterSet::add(std::string name, std::shared_ptr<MemoryFormatter> formatter) {
+    if (!formatter) throw std::invalid_argument("formatter is a nullptr");
+    entries.push_back({std::move(name), std::move(formatter)});
+}
+
+void FormatterSet::add_unowned(std::string name, MemoryFormatter &formatter) {
+    // aliasing constructor with an empty owner: no control block, no reference counting
+    entries.push_back({std::move(name), std::shared_ptr<MemoryFormatter>(std::shared_ptr<void>(), &formatter)});
+}
+
+std::shared_ptr<MemoryFormatter> FormatterSet::add(std::string        name,
+                                                   void              *base_addr,
+                                                   const std::string &addr_string,
+                                                   wordsize           w,
+                                                   format             f,
+                                                   endianness         e) {
+    auto formatter = MemoryFormatter::get_formatter(base_addr, addr_string, w, f, e);
+    add(std::move(name), formatter);
+    return formatter;
+}
+
+/**
+ * @brief get address of the first byte that is read by a formatter
+ * @param formatter formatter
+ * @return address as integer
+ */
+static std::uintptr_t first_address(const MemoryFormatter &formatter) {
+    return reinterpret_cast<std::uintptr_t>(formatter.get_base_address()) + formatter.get_offset();
+}
+
+/**
+ * @brief get address of the last byte that is read by a formatter
+ * @param formatter formatter
+ * @return address as integer
+ */
+static std::uintptr_t last_address(const MemoryFormatter &formatter) {
+    return reinterpret_cast<std::uintptr_t>(formatter.get_base_address()) + formatter.max_offset();
+}
+
+FormatterSet::Region FormatterSet::region() const {
+    if (entries.empty()) return {};
+
+    const auto base = entries.front().formatter->get_base_address();
+    for (const auto &entry : entries)
+        if (entry.formatter->get_base_address() != base)
+            throw std::invalid_argument("the formatters of a memory region must have the same base address");
+
+    auto first = first_address(*entries.front().formatter);
+    auto last  = last_address(*entries.front().formatter);
+    for (const auto &entry : entries) {
+        first = std::min(first, first_address(*entry.formatter));
+        last  = std::max(last, last_address(*entry.formatter));
+    }
+
+    return {reinterpret_cast<volatile void *>(first), last - first + 1};
+}
+
+std::vector<std::size_t> FormatterSet::duplicates() const {
+    std::unordered_map<const MemoryFormatter *, std::size_t> first;
+    first.reserve(entries.size());
+
+    std::vector<std::size_t> result;
+    result.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i)
+        result.push_back(first.emplace(entries[i].formatter.get(), i).first->second);
+    return result;
+}
+
+FormatterSet FormatterSet::unique() const {
+    const auto first = duplicates();
+
+    FormatterSet result;
+    result.access = access;
+    for (std::size_t i = 0; i < entries.size(); ++i)
+        if (first[i] == i) result.entries.push_back(entries[i]);
+    return result;
+}
+
+FormatterSet FormatterSet::rebind(void *region_copy) const {
+    const auto start = reinterpret_cast<std::uintptr_t>(region().address);
+    const auto first = duplicates();
+
+    FormatterSet result;
+    result.entries.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto &entry = entries[i];
+        if (first[i] != i) {
+            result.add(entry.name, result.entries[first[i]].formatter);
+            continue;
+        }
+
+        const auto &f = *entry.formatter;
+        result.add(entry.name, f.relocate(region_copy, first_address(f) - start));
+    }
+
+    result.set_access(memory_access::PLAIN);
+    return result;
+}
+
+}  // namespace memformat
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "Inference.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace memformat {
+
+/**
+ * @brief rate the decoded values with one format
+ * @tparam T unsigned integer type
+ * @tparam Convert function type
+ * @param values decoded values (host byte order)
+ * @param hint expected values
+ * @param convert function that converts a value to double (NaN: value never matches)
+ * @param result interpretation (samples, matches, score, min and max are set)
+ */
+template <typename T, typename Convert>
+static void rate(const std::vector<T> &values, const InferenceHint &hint, Convert convert, Interpretation &result) {
+    std::size_t matches = 0;
+    double      min     = std::numeric_limits<double>::infinity();
+    double      max     = -std::numeric_limits<double>::infinity();
+
+    for (const auto value : values) {
+        const double x     = convert(value);
+        const bool   match = x >= hint.min && x <= hint.max;
+        matches += match;
+        min = match ? std::min(min, x) : min;
+        max = match ? std::max(max, x) : max;
+    }
+
+    result.samples = values.size();
+    result.matches = matches;
+    result.score   = static_cast<double>(matches) / static_cast<double>(values.size());
+    result.min     = matches ? min : std::numeric_limits<double>::quiet_NaN();
+    result.max     = matches ? max : std::numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * @brief decode all values with one word size and endianness and rate them with the requested formats
+ * @tparam T unsigned integer type
+ * @tparam E endianness
+ * @param data memory region
+ * @param count number of values
+ * @param stride distance between two values
+ * @param hint expected values
+ * @param values scratch buffer
+ * @param results output
+ */
+template <typename T, endianness E>
+static void evaluate(const std::byte            *data,
+                     std::size_t                  count,
+                     std::size_t                  stride,
+                     const InferenceHint         &hint,
+                     std::vector<T>              &values,
+                     std::vector<Interpretation> &results) {
+    values.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        values[i] = detail::decode<T, E>(data + i * stride);
+
+    constexpr auto w = sizeof(T) == 1   ? wordsize::BIT_8
+                       : sizeof(T) == 2 ? wordsize::BIT_16
+                       : sizeof(T) == 4 ? wordsize::BIT_32
+                                        : wordsize::BIT_64;
+
+    for (const auto f : hint.formats) {
+        Interpretation result {w, E, f, 0, 0, 0.0, 0.0, 0.0};
+        if (f == format::UNSIGNED) {
+            rate(values, hint, [](T v) { return static_cast<double>(v); }, result);
+        } else if (f == format::SIGNED) {
+            rate(values, hint, [](T v) { return static_cast<double>(static_cast<std::make_signed_t<T>>(v)); }, result);
+        } else if constexpr (sizeof(T) >= 4) {
+            using float_t = std::conditional_t<sizeof(T) == 4, float, double>;
+            rate(
+                    values,
+                    hint,
+                    [](T v) {
+                        float_t x;
+                        std::memcpy(&x, &v, sizeof(x));
+                        const auto category = std::fpclassify(x);
+                        return category == FP_NORMAL || category == FP_ZERO ? static_cast<double>(x)
+                                                                            : std::numeric_limits<double>::quiet_NaN();
+                    },
+                    result);
+        } else {
+            continue;  // no floating point type with this size
+        }
+        results.push_back(result);
+    }
+}
+
+/**
+ * @brief evaluate all interpretations for one word size
+ * @tparam T unsigned integer type
+ * @param data memory region
+ * @param size size of the memory region
+ * @param hint expected values
+ * @param results output
+ */
+template <typename T>
+static void evaluate_wordsize(const std::byte             *data,
+                              std::size_t                  size,
+                              const InferenceHint         &hint,
+                              std::vector<Interpretation> &results) {
+    const auto stride = hint.stride ? hint.stride : sizeof(T);
+    if (size < sizeof(T)) return;
+    const auto count = (size - sizeof(T)) / stride + 1;
+
+    std::vector<T> values;
+    for (const auto e : {endianness::HOST,
+                         endianness::BIG,
+                         endianness::LITTLE,
+                         endianness::BIG_SWAP16,
+                         endianness::LITTLE_SWAP16,
+                         endianness::BIG_SWAP32,
+                         endianness::LITTLE_SWAP32}) {
+        if ((e == endianness::HOST) != (sizeof(T) == 1)) continue;
+
+        detail::with_endianness<T>(e, [&](auto E) {
+            evaluate<T, decltype(E)::value>(data, count, stride, hint, values, results);
+        });
+    }
+}
+
+std::vector<Interpretation> infer_interpretations(const void *data, std::size_t size, const InferenceHint &hint) {
+    if (!(hint.min <= hint.max)) throw std::invalid_argument("invalid value range");
+    for (const auto f : hint.formats) {
+        if (f != format::SIGNED && f != format::UNSIGNED && f != format::FLOAT)
+            throw std::invalid_argument("only the formats SIGNED, UNSIGNED and FLOAT are supported");
+    }
+
+    const auto *bytes = static_cast<const std::byte *>(data);
+
+    std::vector<Interpretation> results;
+    for (const auto w : hint.word_sizes) {
+        switch (w) {
+            case wordsize::BIT_1: throw std::invalid_argument("word size BIT_1 is not supported");
+            case wordsize::BIT_8: evaluate_wordsize<std::uint8_t>(bytes, size, hint, results); break;
+            case wordsize::BIT_16: evaluate_wordsize<std::uint16_t>(bytes, size, hint, results); break;
+            case wordsize::BIT_32: evaluate_wordsize<std::uint32_t>(bytes, size, hint, results); break;
+            case wordsize::BIT_64: evaluate_wordsize<std::uint64_t>(bytes, size, hint, results); break;
+        }
+    }
+
+    std::stable_sort(results.begin(), results.end(), [](const Interpretation &a, const Interpretation &b) {
+        return a.score > b.score;
+    });
+    return results;
+}
+
+}  // namespace memformat
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "Instrumentation.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace memformat::instrumentation {
+
+Counters &Counters::operator+=(const Counters &other) {
+    calls += other.calls;
+    bytes_read += other.bytes_read;
+    bytes_written += other.bytes_written;
+    total_ns += other.total_ns;
+    for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+        histogram[i] += other.histogram[i];
+    return *this;
+}
+
+Counters Snapshot::total() const {
+    Counters result;
+    for (const auto &w : counters) {
+        for (const auto &c : w)
+            result += c;
+    }
+    return result;
+}
+
+#ifdef MEMFORMAT_INSTRUMENTATION
+
+/**
+ * @brief counters of one word size / format combination (updated on the formatting path)
+ */
+struct AtomicCounters {
+    std::atomic<std::uint64_t>                                calls {0};
+    std::atomic<std::uint64_t>                                bytes_read {0};
+    std::atomic<std::uint64_t>                                bytes_written {0};
+    std::atomic<std::uint64_t>                                total_ns {0};
+    std::array<std::atomic<std::uint64_t>, HISTOGRAM_BUCKETS> histogram {};
+};
+
+static AtomicCounters counters[WORDSIZES][FORMATS];  // NOLINT
+
+/**
+ * @brief record a formatter call
+ * @param w word size
+ * @param f format
+ * @param input number of memory bytes that are read
+ * @param output number of output characters
+ * @param ns duration in nanoseconds
+ */
+static void record(wordsize w, format f, std::uint64_t input, std::uint64_t output, std::uint64_t ns) {
+    auto &c = counters[static_cast<std::size_t>(w)][static_cast<std::size_t>(f)];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.bytes_read.fetch_add(input, std::memory_order_relaxed);
+    c.bytes_written.fetch_add(output, std::memory_order_relaxed);
+    c.total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    // the bucket limits are inclusive (exported as Prometheus 'le')
+    std::size_t bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && ns > bucket_limit(bucket))
+        ++bucket;
+    c.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+Snapshot snapshot() {
+    Snapshot result;
+    for (std::size_t w = 0; w < WORDSIZES; ++w) {
+        for (std::size_t f = 0; f < FORMATS; ++f) {
+            const auto &src = counters[w][f];
+            auto       &dst = result.counters[w][f];
+            dst.calls         = src.calls.load(std::memory_order_relaxed);
+            dst.bytes_read    = src.bytes_read.load(std::memory_order_relaxed);
+            dst.bytes_written = src.bytes_written.load(std::memory_order_relaxed);
+            dst.total_ns      = src.total_ns.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                dst.histogram[i] = src.histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+void reset() {
+    for (auto &w : counters) {
+        for (auto &c : w) {
+            c.calls.store(0, std::memory_order_relaxed);
+            c.bytes_read.store(0, std::memory_order_relaxed);
+            c.bytes_written.store(0, std::memory_order_relaxed);
+            c.total_ns.store(0, std::memory_order_relaxed);
+            for (auto &bucket : c.histogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+Snapshot snapshot() { return {}; }
+
+void reset() {}
+
+#endif
+
+/**
+ * @brief get label value of a word size
+ * @param w word size index
+ * @return label value
+ */
+static const char *wordsize_label(std::size_t w) {
+    static constexpr const char *LABELS[WORDSIZES] = {"1", "8", "16", "32", "64"};
+    return LABELS[w];
+}
+
+/**
+ * @brief get label value of a format
+ * @param f format index
+ * @return label value
+ */
+static const char *format_label(std::size_t f) {
+    static constexpr const char *LABELS[FORMATS] = {
+            "bin", "oct", "hex", "signed", "unsigned", "float", "label", "string"};
+    return LABELS[f];
+}
+
+std::string prometheus_text(const Snapshot &snapshot, const std::string &prefix) {
+    std::string result;
+
+    const auto labels = [](std::size_t w, std::size_t f) {
+        return std::string("wordsize=\"") + wordsize_label(w) + "\",format=\"" + format_label(f) + '"';
+    };
+
+    const auto counter = [&](const char *name, const char *help, std::uint64_t Counters::*member) {
+        const auto metric = prefix + name;
+        result += "# HELP " + metric + ' ' + help + '\n';
+        result += "# TYPE " + metric + " counter\n";
+        for (std::size_t w = 0; w < WORDSIZES; ++w) {
+            for (std::size_t f = 0; f < FORMATS; ++f) {
+                const auto &c = snapshot.counters[w][f];
+                if (!c.calls) continue;
+                result += metric + '{' + labels(w, f) + "} " + std::to_string(c.*member) + '\n';
+            }
+        }
+    };
+
+    counter("_format_calls_total", "Number of formatted values.", &Counters::calls);
+    counter("_format_read_bytes_total", "Number of memory bytes read by formatters.", &Counters::bytes_read);
+    counter("_format_output_bytes_total", "Number of characters written by formatters.", &Counters::bytes_written);
+
+    const auto metric = prefix + "_format_duration_nanoseconds";
+    result += "# HELP " + metric + " Formatting time in nanoseconds.\n";
+    result += "# TYPE " + metric + " histogram\n";
+    for (std::size_t w = 0; w < WORDSIZES; ++w) {
+        for (std::size_t f = 0; f < FORMATS; ++f) {
+            const auto &c = snapshot.counters[w][f];
+            if (!c.calls) continue;
+
+            const auto    label      = labels(w, f);
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+                cumulative += c.histogram[i];
+                const auto le = i == HISTOGRAM_BUCKETS - 1 ? std::string("+Inf") : std::to_string(bucket_limit(i));
+                result += metric + "_bucket{" + label + ",le=\"" + le + "\"} " + std::to_string(cumulative) + '\n';
+            }
+            result += metric + "_sum{" + label + "} " + std::to_string(c.total_ns) + '\n';
+            result += metric + "_count{" + label + "} " + std::to_string(c.calls) + '\n';
+        }
+    }
+
+    return result;
+}
+
+}  // namespace memformat::instrumentation
+
+#ifdef MEMFORMAT_INSTRUMENTATION
+
+namespace memformat {
+
+char *MemoryFormatter::instrumented_format_value(volatile void *base, char *dest, memory_access access) const {
+    const auto start = std::chrono::steady_clock::now();
+    auto      *end   = format_value(base, dest, access);
+    const auto stop  = std::chrono::steady_clock::now();
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
+
+    // the memory bytes of the value (a word or a character field)
+    instrumentation::record(word_size,
+                            output_format,
+                            static_cast<std::uint64_t>(max_offset() - offset + 1),
+                            static_cast<std::uint64_t>(end - dest),
+                            static_cast<std::uint64_t>(ns.count()));
+    return end;
+}
+
+}  // namespace memformat
+
+#endif
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_POSIX
+
+#    include "LayoutCache.hpp"
+
+#    include "MemoryFormatterImpl.hpp"
+
+#    include <cerrno>
+#    include <cstdint>
+#    include <cstdio>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <limits>
+#    include <stdexcept>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <system_error>
+#    include <typeinfo>
+#    include <unistd.h>
+#    include <vector>
+
+/*
+ * layout cache file format (host byte order)
+ *
+ *   LayoutHeader
+ *   LayoutEntry[entry_count]
+ *   names (names_size bytes, not null terminated)
+ *
+ * The checksum covers everything behind the header.
+ */
+
+namespace memformat {
+
+namespace detail {
+
+constexpr char          LAYOUT_MAGIC[8]   = {'M', 'E', 'M', 'F', 'L', 'A', 'Y', '\0'};
+constexpr std::uint32_t LAYOUT_VERSION    = 2;
+constexpr std::uint32_t LAYOUT_BYTE_ORDER = 0x01020304;
+
+struct LayoutHeader {
+    char          magic[8];     //*< LAYOUT_MAGIC
+    std::uint32_t version;      //*< LAYOUT_VERSION
+    std::uint32_t byte_order;   //*< LAYOUT_BYTE_ORDER (detects files of hosts with another byte order)
+    std::uint32_t entry_size;   //*< sizeof(LayoutEntry)
+    std::uint32_t access;       //*< memory access semantics of the set (memory_access)
+    std::uint64_t entry_count;  //*< number of entries
+    std::uint64_t names_size;   //*< size of the name table
+    std::uint64_t checksum;     //*< checksum of the entries and the name table
+};
+
+struct LayoutEntry {
+    std::uint64_t offset;       //*< memory offset
+    std::uint64_t first;        //*< index of the first entry with the same formatter instance (own index if none)
+    std::uint64_t name_offset;  //*< position of the name in the name table
+    std::uint32_t name_size;    //*< length of the name
+    std::uint8_t  word_size;    //*< wordsize
+    std::uint8_t  format;       //*< format
+    std::uint8_t  endianness;   //*< endianness
+    std::uint8_t  bit_index;    //*< bit index (BIT_1)
+};
+
+static_assert(sizeof(LayoutHeader) == 48);
+static_assert(sizeof(LayoutEntry) == 32);
+
+}  // namespace detail
+
+/**
+ * @brief calculate the checksum of the file content
+ * @details FNV-1a with 64 bit words (the remaining bytes are processed individually)
+ * @param data data
+ * @param size number of bytes
+ * @return checksum
+ */
+static std::uint64_t checksum(const std::byte *data, std::size_t size) {
+    constexpr std::uint64_t PRIME = 0x100000001B3ULL;
+
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    std::size_t   i    = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+    }
+    for (; i < size; ++i)
+        hash = (hash ^ std::to_integer<std::uint64_t>(data[i])) * PRIME;
+    return hash;
+}
+
+/**
+ * @brief write the complete buffer to a file descriptor
+ * @param fd file descriptor
+ * @param data data
+ * @param size number of bytes
+ */
+static void write_all(int fd, const std::byte *data, std::size_t size) {
+    while (size) {
+        const auto result = ::write(fd, data, size);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+        data += result;
+        size -= static_cast<std::size_t>(result);
+    }
+}
+
+void LayoutCache::write(const std::string &path, const FormatterSet &set) {
+    const auto first = set.duplicates();
+
+    std::vector<detail::LayoutEntry> entries;
+    std::string                      names;
+    entries.reserve(set.size());
+
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        const auto &[name, formatter] = set[i];
+        const auto &f                 = *formatter;
+        if (f.get_base_address() != set[0].formatter->get_base_address())
+            throw std::invalid_argument("the formatters of a layout cache must have the same base address");
+
+        // only built-in formatters can be recreated from the stored arguments
+        if (f.get_format() == format::LABEL || f.get_format() == format::STRING)
+            throw std::invalid_argument("formatter '" + name + "' was not created by MemoryFormatter::get_formatter");
+        const auto reference = detail::new_formatter(
+                nullptr, f.get_offset(), f.get_wordsize(), f.get_format(), f.get_endianness(), f.get_bit_index());
+        if (typeid(*reference) != typeid(f))
+            throw std::invalid_argument("formatter '" + name + "' was not created by MemoryFormatter::get_formatter");
+
+        if (name.size() > std::numeric_limits<std::uint32_t>::max()) throw std::invalid_argument("name too long");
+
+        detail::LayoutEntry record {};
+        record.offset      = f.get_offset();
+        record.first       = first[i];
+        record.name_offset = names.size();
+        record.name_size   = static_cast<std::uint32_t>(name.size());
+        record.word_size   = static_cast<std::uint8_t>(f.get_wordsize());
+        record.format      = static_cast<std::uint8_t>(f.get_format());
+        record.endianness  = static_cast<std::uint8_t>(f.get_endianness());
+        record.bit_index   = static_cast<std::uint8_t>(f.get_bit_index());
+        entries.push_back(record);
+        names += name;
+    }
+
+    const auto entries_size = entries.size() * sizeof(detail::LayoutEntry);
+
+    std::vector<std::byte> content(sizeof(detail::LayoutHeader) + entries_size + names.size());
+    if (!entries.empty()) {
+        std::memcpy(content.data() + sizeof(detail::LayoutHeader), entries.data(), entries_size);
+        std::memcpy(content.data() + sizeof(detail::LayoutHeader) + entries_size, names.data(), names.size());
+    }
+
+    detail::LayoutHeader header {};
+    std::memcpy(header.magic, detail::LAYOUT_MAGIC, sizeof(header.magic));
+    header.version     = detail::LAYOUT_VERSION;
+    header.byte_order  = detail::LAYOUT_BYTE_ORDER;
+    header.access      = static_cast<std::uint32_t>(set.get_access());
+    header.entry_size  = sizeof(detail::LayoutEntry);
+    header.entry_count = entries.size();
+    header.names_size  = names.size();
+    header.checksum    = checksum(content.data() + sizeof(header), content.size() - sizeof(header));
+    std::memcpy(content.data(), &header, sizeof(header));
+
+    // write a temporary file and replace the cache atomically
+    const auto tmp_path = path + ".tmp" + std::to_string(getpid());
+    const int  fd       = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "failed to open " + tmp_path);
+
+    try {
+        write_all(fd, content.data(), content.size());
+        if (::fsync(fd) != 0) throw std::system_error(errno, std::generic_category(), "fsync");
+    } catch (...) {
+        ::close(fd);
+        ::unlink(tmp_path.c_str());
+        throw;
+    }
+
+    if (::close(fd) != 0 || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        const auto error = errno;
+        ::unlink(tmp_path.c_str());
+        throw std::system_error(error, std::generic_category(), "failed to write " + path);
+    }
+}
+
+LayoutCache::LayoutCache(const std::string &path, bool verify) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "failed to open " + path);
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    file_size = static_cast<std::size_t>(st.st_size);
+    if (file_size < sizeof(detail::LayoutHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a valid layout cache");
+    }
+
+    void      *addr  = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto error = errno;
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::system_error(error, std::generic_category(), "mmap");
+    file = static_cast<const std::byte *>(addr);
+
+    detail::LayoutHeader header {};
+    std::memcpy(&header, file, sizeof(header));
+
+    const auto content_size = file_size - sizeof(header);
+    const auto entries_max  = content_size / sizeof(detail::LayoutEntry);
+
+    bool valid = std::memcmp(header.magic, detail::LAYOUT_MAGIC, sizeof(header.magic)) == 0;
+    valid      = valid && header.version == detail::LAYOUT_VERSION && header.byte_order == detail::LAYOUT_BYTE_ORDER;
+    valid      = valid && header.entry_size == sizeof(detail::LayoutEntry) && header.entry_count <= entries_max;
+    valid      = valid && header.names_size == content_size - header.entry_count * sizeof(detail::LayoutEntry);
+    valid      = valid && header.access <= static_cast<std::uint32_t>(memory_access::ACQUIRE);
+
+    if (!valid || (verify && checksum(file + sizeof(header), content_size) != header.checksum)) {
+        munmap(const_cast<std::byte *>(file), file_size);
+        throw std::runtime_error(path + " is not a valid layout cache");
+    }
+
+    count  = header.entry_count;
+    access = static_cast<memory_access>(header.access);
+}
+
+LayoutCache::~LayoutCache() { munmap(const_cast<std::byte *>(file), file_size); }
+
+/**
+ * @brief read an entry of the mapped file
+ * @param entries start of the entries
+ * @param i entry index
+ * @return entry
+ */
+static detail::LayoutEntry read_entry(const std::byte *entries, std::size_t i) {
+    detail::LayoutEntry record {};
+    std::memcpy(&record, entries + i * sizeof(detail::LayoutEntry), sizeof(record));
+    return record;
+}
+
+LayoutCache::Entry LayoutCache::entry(std::size_t i) const {
+    if (i >= count) throw std::out_of_range("layout cache entry index out of range");
+
+    const auto *entries    = file + sizeof(detail::LayoutHeader);
+    const auto *names      = entries + count * sizeof(detail::LayoutEntry);
+    const auto  names_size = file_size - static_cast<std::size_t>(names - file);
+
+    const auto record = read_entry(entries, i);
+
+    if (record.name_offset > names_size || record.name_size > names_size - record.name_offset ||
+        record.word_size > static_cast<std::uint8_t>(wordsize::BIT_64) ||
+        record.format > static_cast<std::uint8_t>(format::FLOAT) ||
+        record.endianness > static_cast<std::uint8_t>(endianness::LITTLE_SWAP32) || record.first > i)
+        throw std::runtime_error("corrupt layout cache entry");
+
+    // a shared formatter instance is only valid if both entries describe the same value
+    if (record.first != i) {
+        const auto shared = read_entry(entries, record.first);
+        if (shared.first != record.first || shared.offset != record.offset || shared.word_size != record.word_size ||
+            shared.format != record.format || shared.endianness != record.endianness ||
+            shared.bit_index != record.bit_index)
+            throw std::runtime_error("corrupt layout cache entry");
+    }
+
+    return {std::string_view(reinterpret_cast<const char *>(names + record.name_offset), record.name_size),
+            record.offset,
+            static_cast<wordsize>(record.word_size),
+            static_cast<format>(record.format),
+            static_cast<endianness>(record.endianness),
+            record.bit_index,
+            record.first};
+}
+
+std::shared_ptr<MemoryFormatter> LayoutCache::formatter(std::size_t i, void *base_addr) const {
+    const auto e = entry(i);
+    try {
+        return MemoryFormatter::get_formatter(base_addr, e.offset, e.w, e.f, e.e, e.bit_index);
+    } catch (const std::logic_error &) {
+        // combinations that are rejected by get_formatter are never written
+        throw std::runtime_error("corrupt layout cache entry");
+    }
+}
+
+FormatterSet LayoutCache::create(void *base_addr) const {
+    FormatterSet set;
+    set.set_access(access);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto e = entry(i);
+
+        // entries that shared a formatter instance share the new instance
+        if (e.first != i)
+            set.add(std::string(e.name), set[e.first].formatter);
+        else
+            set.add(std::string(e.name), formatter(i, base_addr));
+    }
+    return set;
+}
+
+}  // namespace memformat
+
+#endif
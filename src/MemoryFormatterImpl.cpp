@@ -5,39 +5,115 @@
 
 #include "MemoryFormatterImpl.hpp"
 
+#include "FormatterPool.hpp"
+#include "MemoryFormatterDetail.hpp"
 #include "endian.hpp"
 #include "split_string.hpp"
 
-#include <bitset>
-#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 
 namespace memformat {
 
+char *MemoryFormatter::format_value(volatile void *base, char *dest, memory_access) const {
+    if (base != base_address) throw std::logic_error("formatter does not support other base addresses");
+
+    const auto str = string();
+    return std::copy(str.begin(), str.end(), dest);
+}
+
+std::string MemoryFormatter::format_string() const {
+    char buffer[MAX_STRING_LENGTH];
+    return std::string(buffer, format_to(base_address, buffer));
+}
+
+void MemoryFormatter::append_to(volatile void *base, std::string &out, memory_access access) const {
+    char buffer[MAX_STRING_LENGTH];
+    out.append(buffer, format_to(base, buffer, access));
+}
+
+std::shared_ptr<MemoryFormatter> MemoryFormatter::relocate(void *base, std::size_t offset) const {
+    return get_formatter(base, offset, word_size, output_format, endian, get_bit_index());
+}
+
+std::uint64_t MemoryFormatter::raw_value(volatile void *, memory_access) const {
+    throw std::logic_error("formatter does not provide raw values");
+}
+
+Value MemoryFormatter::value(volatile void *base, memory_access access) const {
+    const auto raw = raw_value(base, access);
+    if (word_size == wordsize::BIT_1) return raw != 0;
+
+    switch (output_format) {
+        case format::SIGNED:
+            switch (word_size) {
+                case wordsize::BIT_8: return static_cast<std::int64_t>(static_cast<std::int8_t>(raw));
+                case wordsize::BIT_16: return static_cast<std::int64_t>(static_cast<std::int16_t>(raw));
+                case wordsize::BIT_32: return static_cast<std::int64_t>(static_cast<std::int32_t>(raw));
+                case wordsize::BIT_1:
+                case wordsize::BIT_64: return static_cast<std::int64_t>(raw);
+            }
+            break;
+        case format::FLOAT:
+            if (word_size == wordsize::BIT_32) {
+                const auto raw32 = static_cast<std::uint32_t>(raw);
+                float      result;
+                std::memcpy(&result, &raw32, sizeof(result));
+                return static_cast<double>(result);
+            } else {
+                double result;
+                std::memcpy(&result, &raw, sizeof(result));
+                return result;
+            }
+        case format::BIN:
+        case format::OCT:
+        case format::HEX:
+        case format::UNSIGNED:
+        case format::LABEL:
+        case format::STRING: break;
+    }
+
+    return raw;
+}
+
 MemoryFormatter_Bit_1::MemoryFormatter_Bit_1(void *base_address, std::size_t offset, std::size_t bit_offset)
-    : MemoryFormatter(base_address, offset), bit_offset(bit_offset) {}
+    : MemoryFormatter(base_address, offset, wordsize::BIT_1, format::BIN, endianness::HOST), bit_offset(bit_offset) {}
+
+std::string MemoryFormatter_Bit_1::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_1::string() const {
-    const auto byte = *(reinterpret_cast<volatile uint8_t *>(base_address) + offset);
-    const auto bit  = (byte >> bit_offset) & 0x1;
-    return bit ? "1" : "0";
+char *MemoryFormatter_Bit_1::format_value(volatile void *base, char *dest, memory_access access) const {
+    const auto byte = detail::load<uint8_t>(base, offset, true, access);
+    *dest           = static_cast<char>('0' + ((byte >> bit_offset) & 0x1));
+    return dest + 1;
 }
 
 size_t MemoryFormatter_Bit_1::max_offset() const { return offset; }
 
+std::uint64_t MemoryFormatter_Bit_1::raw_value(volatile void *base, memory_access access) const {
+    const auto byte = detail::load<uint8_t>(base, offset, true, access);
+    return (byte >> bit_offset) & 0x1;
+}
+
 
-MemoryFormatter_Bit_8::MemoryFormatter_Bit_8(void *base_address, std::size_t offset, endianness)
-    : MemoryFormatter(base_address, offset) {}
+MemoryFormatter_Bit_8::MemoryFormatter_Bit_8(void *base_address, std::size_t offset, endianness, format f)
+    : MemoryFormatter(base_address, offset, wordsize::BIT_8, f, endianness::HOST) {}
 
 std::size_t MemoryFormatter_Bit_8::max_offset() const { return offset; }
 
-uint8_t MemoryFormatter_Bit_8::get_data() const {
-    return *(reinterpret_cast<volatile uint8_t *>(base_address) + offset);
+std::uint64_t MemoryFormatter_Bit_8::raw_value(volatile void *base, memory_access access) const {
+    return get_data(base, access);
 }
 
-MemoryFormatter_Bit_16::MemoryFormatter_Bit_16(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter(base_address, offset) {
+uint8_t MemoryFormatter_Bit_8::get_data(volatile void *base, memory_access access) const {
+    return detail::load<uint8_t>(base, offset, true, access);
+}
+
+MemoryFormatter_Bit_16::MemoryFormatter_Bit_16(void *base_address, std::size_t offset, endianness endian, format f)
+    : MemoryFormatter(base_address, offset, wordsize::BIT_16, f, endian),
+      aligned(detail::is_aligned<uint16_t>(reinterpret_cast<std::uintptr_t>(base_address) + offset)) {
     switch (endian) {
         case endianness::HOST: convert_endianess = [](uint16_t data) { return data; }; break;
         case endianness::BIG: convert_endianess = [](uint16_t data) { return ::endian::big_to_host(data); }; break;
@@ -57,13 +133,21 @@ MemoryFormatter_Bit_16::MemoryFormatter_Bit_16(void *base_address, std::size_t o
 
 std::size_t MemoryFormatter_Bit_16::max_offset() const { return offset + 1; }
 
-uint16_t MemoryFormatter_Bit_16::get_data() const {
-    return convert_endianess(
-            *reinterpret_cast<volatile uint16_t *>((reinterpret_cast<volatile uint8_t *>(base_address) + offset)));
+std::uint64_t MemoryFormatter_Bit_16::raw_value(volatile void *base, memory_access access) const {
+    return get_data(base, access);
+}
+
+uint16_t MemoryFormatter_Bit_16::get_data(volatile void *base, memory_access access) const {
+    // the alignment of relocated base addresses is checked per call
+    const auto address    = reinterpret_cast<std::uintptr_t>(base) + offset;
+    const auto is_aligned = base == base_address ? aligned : detail::is_aligned<uint16_t>(address);
+    const auto raw        = detail::load<uint16_t>(base, offset, is_aligned, access);
+    return convert_endianess(raw);
 }
 
-MemoryFormatter_Bit_32::MemoryFormatter_Bit_32(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter(base_address, offset) {
+MemoryFormatter_Bit_32::MemoryFormatter_Bit_32(void *base_address, std::size_t offset, endianness endian, format f)
+    : MemoryFormatter(base_address, offset, wordsize::BIT_32, f, endian),
+      aligned(detail::is_aligned<uint32_t>(reinterpret_cast<std::uintptr_t>(base_address) + offset)) {
     switch (endian) {
         case endianness::HOST: convert_endianess = [](uint32_t data) { return data; }; break;
         case endianness::BIG: convert_endianess = [](uint32_t data) { return ::endian::big_to_host(data); }; break;
@@ -101,13 +185,21 @@ MemoryFormatter_Bit_32::MemoryFormatter_Bit_32(void *base_address, std::size_t o
 
 std::size_t MemoryFormatter_Bit_32::max_offset() const { return offset + 3; }
 
-uint32_t MemoryFormatter_Bit_32::get_data() const {
-    return convert_endianess(
-            *reinterpret_cast<volatile uint32_t *>((reinterpret_cast<volatile uint8_t *>(base_address) + offset)));
+std::uint64_t MemoryFormatter_Bit_32::raw_value(volatile void *base, memory_access access) const {
+    return get_data(base, access);
+}
+
+uint32_t MemoryFormatter_Bit_32::get_data(volatile void *base, memory_access access) const {
+    // the alignment of relocated base addresses is checked per call
+    const auto address    = reinterpret_cast<std::uintptr_t>(base) + offset;
+    const auto is_aligned = base == base_address ? aligned : detail::is_aligned<uint32_t>(address);
+    const auto raw        = detail::load<uint32_t>(base, offset, is_aligned, access);
+    return convert_endianess(raw);
 }
 
-MemoryFormatter_Bit_64::MemoryFormatter_Bit_64(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter(base_address, offset) {
+MemoryFormatter_Bit_64::MemoryFormatter_Bit_64(void *base_address, std::size_t offset, endianness endian, format f)
+    : MemoryFormatter(base_address, offset, wordsize::BIT_64, f, endian),
+      aligned(detail::is_aligned<uint64_t>(reinterpret_cast<std::uintptr_t>(base_address) + offset)) {
     switch (endian) {
         case endianness::HOST: convert_endianess = [](uint64_t data) { return data; }; break;
         case endianness::BIG: convert_endianess = [](uint64_t data) { return ::endian::big_to_host(data); }; break;
@@ -165,273 +257,361 @@ MemoryFormatter_Bit_64::MemoryFormatter_Bit_64(void *base_address, std::size_t o
 
 std::size_t MemoryFormatter_Bit_64::max_offset() const { return offset + 7; }
 
-uint64_t MemoryFormatter_Bit_64::get_data() const {
-    auto data_raw =
-            *reinterpret_cast<volatile uint64_t *>((reinterpret_cast<volatile uint8_t *>(base_address) + offset));
-    auto data_endian = convert_endianess(data_raw);
-    return data_endian;
+std::uint64_t MemoryFormatter_Bit_64::raw_value(volatile void *base, memory_access access) const {
+    return get_data(base, access);
+}
+
+uint64_t MemoryFormatter_Bit_64::get_data(volatile void *base, memory_access access) const {
+    // the alignment of relocated base addresses is checked per call
+    const auto address    = reinterpret_cast<std::uintptr_t>(base) + offset;
+    const auto is_aligned = base == base_address ? aligned : detail::is_aligned<uint64_t>(address);
+    const auto raw        = detail::load<uint64_t>(base, offset, is_aligned, access);
+    return convert_endianess(raw);
 }
 
 MemoryFormatter_Bit_8_Bin::MemoryFormatter_Bit_8_Bin(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_8(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_8(base_address, offset, endian, format::BIN) {}
+
+std::string MemoryFormatter_Bit_8_Bin::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_8_Bin::string() const {
-    std::ostringstream result;
-    result << std::bitset<8>(get_data());
-    return result.str();
+char *MemoryFormatter_Bit_8_Bin::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::bin_to_chars<8>(dest, get_data(base, access));
 }
 
 MemoryFormatter_Bit_8_Hex::MemoryFormatter_Bit_8_Hex(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_8(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_8(base_address, offset, endian, format::HEX) {}
 
-std::string MemoryFormatter_Bit_8_Hex::string() const {
-    std::ostringstream result;
-    result << std::hex << static_cast<std::size_t>(get_data());
-    return result.str();
+std::string MemoryFormatter_Bit_8_Hex::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_8_Hex::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 16);
 }
 
 MemoryFormatter_Bit_8_Oct::MemoryFormatter_Bit_8_Oct(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_8(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_8(base_address, offset, endian, format::OCT) {}
+
+std::string MemoryFormatter_Bit_8_Oct::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_8_Oct::string() const {
-    std::ostringstream result;
-    result << std::oct << static_cast<std::size_t>(get_data());
-    return result.str();
+char *MemoryFormatter_Bit_8_Oct::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 8);
 }
 
 MemoryFormatter_Bit_8_Signed::MemoryFormatter_Bit_8_Signed(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_8(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_8(base_address, offset, endian, format::SIGNED) {}
+
+std::string MemoryFormatter_Bit_8_Signed::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_8_Signed::string() const {
-    auto value = get_data();
-    return std::to_string(static_cast<int>(*reinterpret_cast<int8_t *>(&value)));
+char *MemoryFormatter_Bit_8_Signed::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value = get_data(base, access);
+    return detail::int_to_chars(dest, *reinterpret_cast<int8_t *>(&value));
 }
 
 MemoryFormatter_Bit_8_Unsigned::MemoryFormatter_Bit_8_Unsigned(void       *base_address,
                                                                std::size_t offset,
                                                                endianness  endian)
-    : MemoryFormatter_Bit_8(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_8(base_address, offset, endian, format::UNSIGNED) {}
 
-std::string MemoryFormatter_Bit_8_Unsigned::string() const { return std::to_string(static_cast<unsigned>(get_data())); }
+std::string MemoryFormatter_Bit_8_Unsigned::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_8_Unsigned::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access));
+}
 
 MemoryFormatter_Bit_16_Bin::MemoryFormatter_Bit_16_Bin(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_16(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_16(base_address, offset, endian, format::BIN) {}
+
+std::string MemoryFormatter_Bit_16_Bin::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_16_Bin::string() const {
-    std::ostringstream result;
-    result << std::bitset<16>(get_data());
-    return result.str();
+char *MemoryFormatter_Bit_16_Bin::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::bin_to_chars<16>(dest, get_data(base, access));
 }
 
 MemoryFormatter_Bit_16_Hex::MemoryFormatter_Bit_16_Hex(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_16(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_16(base_address, offset, endian, format::HEX) {}
 
-std::string MemoryFormatter_Bit_16_Hex::string() const {
-    std::ostringstream result;
-    result << std::hex << get_data();
-    return result.str();
+std::string MemoryFormatter_Bit_16_Hex::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_16_Hex::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 16);
 }
 
 MemoryFormatter_Bit_16_Oct::MemoryFormatter_Bit_16_Oct(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_16(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_16(base_address, offset, endian, format::OCT) {}
+
+std::string MemoryFormatter_Bit_16_Oct::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_16_Oct::string() const {
-    std::ostringstream result;
-    result << std::oct << get_data();
-    return result.str();
+char *MemoryFormatter_Bit_16_Oct::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 8);
 }
 
 MemoryFormatter_Bit_16_Signed::MemoryFormatter_Bit_16_Signed(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_16(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_16(base_address, offset, endian, format::SIGNED) {}
+
+std::string MemoryFormatter_Bit_16_Signed::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_16_Signed::string() const {
-    auto value = get_data();
-    return std::to_string(*reinterpret_cast<int16_t *>(&value));
+char *MemoryFormatter_Bit_16_Signed::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value = get_data(base, access);
+    return detail::int_to_chars(dest, *reinterpret_cast<int16_t *>(&value));
 }
 
 MemoryFormatter_Bit_16_Unsigned::MemoryFormatter_Bit_16_Unsigned(void       *base_address,
                                                                  std::size_t offset,
                                                                  endianness  endian)
-    : MemoryFormatter_Bit_16(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_16(base_address, offset, endian, format::UNSIGNED) {}
 
-std::string MemoryFormatter_Bit_16_Unsigned::string() const { return std::to_string(get_data()); }
+std::string MemoryFormatter_Bit_16_Unsigned::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_16_Unsigned::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access));
+}
 
 MemoryFormatter_Bit_32_Bin::MemoryFormatter_Bit_32_Bin(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::BIN) {}
+
+std::string MemoryFormatter_Bit_32_Bin::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_32_Bin::string() const {
-    std::ostringstream result;
-    result << std::bitset<32>(get_data());
-    return result.str();
+char *MemoryFormatter_Bit_32_Bin::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::bin_to_chars<32>(dest, get_data(base, access));
 }
 
 MemoryFormatter_Bit_32_Hex::MemoryFormatter_Bit_32_Hex(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::HEX) {}
 
-std::string MemoryFormatter_Bit_32_Hex::string() const {
-    std::ostringstream result;
-    result << std::hex << get_data();
-    return result.str();
+std::string MemoryFormatter_Bit_32_Hex::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_32_Hex::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 16);
 }
 
 MemoryFormatter_Bit_32_Oct::MemoryFormatter_Bit_32_Oct(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::OCT) {}
+
+std::string MemoryFormatter_Bit_32_Oct::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_32_Oct::string() const {
-    std::ostringstream result;
-    result << std::oct << get_data();
-    return result.str();
+char *MemoryFormatter_Bit_32_Oct::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 8);
 }
 
 MemoryFormatter_Bit_32_Signed::MemoryFormatter_Bit_32_Signed(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::SIGNED) {}
 
-std::string MemoryFormatter_Bit_32_Signed::string() const {
-    auto value = get_data();
-    return std::to_string(*reinterpret_cast<int32_t *>(&value));
+std::string MemoryFormatter_Bit_32_Signed::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_32_Signed::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value = get_data(base, access);
+    return detail::int_to_chars(dest, *reinterpret_cast<int32_t *>(&value));
 }
 
 MemoryFormatter_Bit_32_Unsigned::MemoryFormatter_Bit_32_Unsigned(void       *base_address,
                                                                  std::size_t offset,
                                                                  endianness  endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::UNSIGNED) {}
+
+std::string MemoryFormatter_Bit_32_Unsigned::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_32_Unsigned::string() const { return std::to_string(get_data()); }
+char *MemoryFormatter_Bit_32_Unsigned::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access));
+}
 
 MemoryFormatter_Bit_32_Float::MemoryFormatter_Bit_32_Float(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_32(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_32(base_address, offset, endian, format::FLOAT) {}
 
-std::string MemoryFormatter_Bit_32_Float::string() const {
-    auto value    = get_data();
+std::string MemoryFormatter_Bit_32_Float::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_32_Float::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value    = get_data(base, access);
     auto void_ptr = reinterpret_cast<void *>(&value);
-    return std::to_string(*reinterpret_cast<float *>(void_ptr));
+    return detail::float_to_chars(dest, *reinterpret_cast<float *>(void_ptr));
 }
 
 MemoryFormatter_Bit_64_Bin::MemoryFormatter_Bit_64_Bin(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::BIN) {}
+
+std::string MemoryFormatter_Bit_64_Bin::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_64_Bin::string() const {
-    std::ostringstream result;
-    result << std::bitset<64>(get_data());
-    return result.str();
+char *MemoryFormatter_Bit_64_Bin::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::bin_to_chars<64>(dest, get_data(base, access));
 }
 
 MemoryFormatter_Bit_64_Hex::MemoryFormatter_Bit_64_Hex(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::HEX) {}
+
+std::string MemoryFormatter_Bit_64_Hex::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_64_Hex::string() const {
-    std::ostringstream result;
-    result << std::hex << get_data();
-    return result.str();
+char *MemoryFormatter_Bit_64_Hex::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 16);
 }
 
 MemoryFormatter_Bit_64_Oct::MemoryFormatter_Bit_64_Oct(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::OCT) {}
 
-std::string MemoryFormatter_Bit_64_Oct::string() const {
-    std::ostringstream result;
-    result << std::oct << get_data();
-    return result.str();
+std::string MemoryFormatter_Bit_64_Oct::string() const { return format_string(); }
+
+char *MemoryFormatter_Bit_64_Oct::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access), 8);
 }
 
 MemoryFormatter_Bit_64_Signed::MemoryFormatter_Bit_64_Signed(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::SIGNED) {}
+
+std::string MemoryFormatter_Bit_64_Signed::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_64_Signed::string() const {
-    auto value = get_data();
-    return std::to_string(*reinterpret_cast<int64_t *>(&value));
+char *MemoryFormatter_Bit_64_Signed::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value = get_data(base, access);
+    return detail::int_to_chars(dest, *reinterpret_cast<int64_t *>(&value));
 }
 
 MemoryFormatter_Bit_64_Unsigned::MemoryFormatter_Bit_64_Unsigned(void       *base_address,
                                                                  std::size_t offset,
                                                                  endianness  endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::UNSIGNED) {}
+
+std::string MemoryFormatter_Bit_64_Unsigned::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_64_Unsigned::string() const { return std::to_string(get_data()); }
+char *MemoryFormatter_Bit_64_Unsigned::format_value(volatile void *base, char *dest, memory_access access) const {
+    return detail::int_to_chars(dest, get_data(base, access));
+}
 
 MemoryFormatter_Bit_64_Float::MemoryFormatter_Bit_64_Float(void *base_address, std::size_t offset, endianness endian)
-    : MemoryFormatter_Bit_64(base_address, offset, endian) {}
+    : MemoryFormatter_Bit_64(base_address, offset, endian, format::FLOAT) {}
+
+std::string MemoryFormatter_Bit_64_Float::string() const { return format_string(); }
 
-std::string MemoryFormatter_Bit_64_Float::string() const {
-    auto value    = get_data();
+char *MemoryFormatter_Bit_64_Float::format_value(volatile void *base, char *dest, memory_access access) const {
+    auto value    = get_data(base, access);
     auto void_ptr = reinterpret_cast<void *>(&value);
-    auto d        = *reinterpret_cast<double *>(void_ptr);
-    return std::to_string(d);
+    return detail::float_to_chars(dest, *reinterpret_cast<double *>(void_ptr));
 }
 
+/**
+ * @brief creates formatters with std::make_shared
+ */
+struct SharedMaker {
+    using result_type = std::shared_ptr<MemoryFormatter>;
+
+    template <typename T, typename... Args>
+    result_type make(Args &&...args) const {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief creates formatters in a memory resource
+ */
+struct ResourceMaker {
+    using result_type = FormatterHandle;
+
+    std::pmr::memory_resource &resource;
+
+    template <typename T, typename... Args>
+    result_type make(Args &&...args) const {
+        void *memory = resource.allocate(sizeof(T), alignof(T));
+        try {
+            return FormatterHandle(new (memory) T(std::forward<Args>(args)...), {&resource, sizeof(T), alignof(T)});
+        } catch (...) {
+            resource.deallocate(memory, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+};
+
 /**
  * @brief get 8 bit formatter
+ * @tparam Maker SharedMaker or ResourceMaker
+ * @param maker formatter factory
  * @param base_addr memory base address
  * @param offset memory offset (bytes)
  * @param e endianness
  * @param f format
- * @return shared pointer that holds a MemoryFormatter instance
+ * @return MemoryFormatter instance
  */
-static std::shared_ptr<MemoryFormatter> get_formatter_8(void *base_addr, std::size_t offset, endianness e, format f) {
+template <typename Maker>
+static typename Maker::result_type
+        get_formatter_8(const Maker &maker, void *base_addr, std::size_t offset, endianness e, format f) {
     switch (f) {
-        case format::BIN: return std::make_shared<MemoryFormatter_Bit_8_Bin>(base_addr, offset, e);
-        case format::HEX: return std::make_shared<MemoryFormatter_Bit_8_Hex>(base_addr, offset, e);
-        case format::OCT: return std::make_shared<MemoryFormatter_Bit_8_Oct>(base_addr, offset, e);
-        case format::SIGNED: return std::make_shared<MemoryFormatter_Bit_8_Signed>(base_addr, offset, e);
-        case format::UNSIGNED: return std::make_shared<MemoryFormatter_Bit_8_Unsigned>(base_addr, offset, e);
+        case format::BIN: return maker.template make<MemoryFormatter_Bit_8_Bin>(base_addr, offset, e);
+        case format::HEX: return maker.template make<MemoryFormatter_Bit_8_Hex>(base_addr, offset, e);
+        case format::OCT: return maker.template make<MemoryFormatter_Bit_8_Oct>(base_addr, offset, e);
+        case format::SIGNED: return maker.template make<MemoryFormatter_Bit_8_Signed>(base_addr, offset, e);
+        case format::UNSIGNED: return maker.template make<MemoryFormatter_Bit_8_Unsigned>(base_addr, offset, e);
         case format::FLOAT: throw std::invalid_argument("Format FLOAT is not allowed for 8 bit values");
+        case format::LABEL: throw std::invalid_argument("Format LABEL requires a label table");
+        case format::STRING: throw std::invalid_argument("Format STRING requires a field length");
     }
 }
 
 /**
  * @brief get 16 bit formatter
+ * @tparam Maker SharedMaker or ResourceMaker
+ * @param maker formatter factory
  * @param base_addr memory base address
  * @param offset memory offset (bytes)
  * @param e endianness
  * @param f format
- * @return shared pointer that holds a MemoryFormatter instance
+ * @return MemoryFormatter instance
  */
-static std::shared_ptr<MemoryFormatter> get_formatter_16(void *base_addr, std::size_t offset, endianness e, format f) {
+template <typename Maker>
+static typename Maker::result_type
+        get_formatter_16(const Maker &maker, void *base_addr, std::size_t offset, endianness e, format f) {
     switch (f) {
-        case format::BIN: return std::make_shared<MemoryFormatter_Bit_16_Bin>(base_addr, offset, e);
-        case format::HEX: return std::make_shared<MemoryFormatter_Bit_16_Hex>(base_addr, offset, e);
-        case format::OCT: return std::make_shared<MemoryFormatter_Bit_16_Oct>(base_addr, offset, e);
-        case format::SIGNED: return std::make_shared<MemoryFormatter_Bit_16_Signed>(base_addr, offset, e);
-        case format::UNSIGNED: return std::make_shared<MemoryFormatter_Bit_16_Unsigned>(base_addr, offset, e);
+        case format::BIN: return maker.template make<MemoryFormatter_Bit_16_Bin>(base_addr, offset, e);
+        case format::HEX: return maker.template make<MemoryFormatter_Bit_16_Hex>(base_addr, offset, e);
+        case format::OCT: return maker.template make<MemoryFormatter_Bit_16_Oct>(base_addr, offset, e);
+        case format::SIGNED: return maker.template make<MemoryFormatter_Bit_16_Signed>(base_addr, offset, e);
+        case format::UNSIGNED: return maker.template make<MemoryFormatter_Bit_16_Unsigned>(base_addr, offset, e);
         case format::FLOAT: throw std::invalid_argument("Format FLOAT is not allowed for 16 bit values");
+        case format::LABEL: throw std::invalid_argument("Format LABEL requires a label table");
+        case format::STRING: throw std::invalid_argument("Format STRING requires a field length");
     }
 }
 
 /**
  * @brief get 32 bit formatter
+ * @tparam Maker SharedMaker or ResourceMaker
+ * @param maker formatter factory
  * @param base_addr memory base address
  * @param offset memory offset (bytes)
  * @param e endianness
  * @param f format
- * @return shared pointer that holds a MemoryFormatter instance
+ * @return MemoryFormatter instance
  */
-static std::shared_ptr<MemoryFormatter> get_formatter_32(void *base_addr, std::size_t offset, endianness e, format f) {
+template <typename Maker>
+static typename Maker::result_type
+        get_formatter_32(const Maker &maker, void *base_addr, std::size_t offset, endianness e, format f) {
     switch (f) {
-        case format::BIN: return std::make_shared<MemoryFormatter_Bit_32_Bin>(base_addr, offset, e);
-        case format::HEX: return std::make_shared<MemoryFormatter_Bit_32_Hex>(base_addr, offset, e);
-        case format::OCT: return std::make_shared<MemoryFormatter_Bit_32_Oct>(base_addr, offset, e);
-        case format::SIGNED: return std::make_shared<MemoryFormatter_Bit_32_Signed>(base_addr, offset, e);
-        case format::UNSIGNED: return std::make_shared<MemoryFormatter_Bit_32_Unsigned>(base_addr, offset, e);
-        case format::FLOAT: return std::make_shared<MemoryFormatter_Bit_32_Float>(base_addr, offset, e);
+        case format::BIN: return maker.template make<MemoryFormatter_Bit_32_Bin>(base_addr, offset, e);
+        case format::HEX: return maker.template make<MemoryFormatter_Bit_32_Hex>(base_addr, offset, e);
+        case format::OCT: return maker.template make<MemoryFormatter_Bit_32_Oct>(base_addr, offset, e);
+        case format::SIGNED: return maker.template make<MemoryFormatter_Bit_32_Signed>(base_addr, offset, e);
+        case format::UNSIGNED: return maker.template make<MemoryFormatter_Bit_32_Unsigned>(base_addr, offset, e);
+        case format::FLOAT: return maker.template make<MemoryFormatter_Bit_32_Float>(base_addr, offset, e);
+        case format::LABEL: throw std::invalid_argument("Format LABEL requires a label table");
+        case format::STRING: throw std::invalid_argument("Format STRING requires a field length");
     }
 }
 
 /**
  * @brief get 64 bit formatter
+ * @tparam Maker SharedMaker or ResourceMaker
+ * @param maker formatter factory
  * @param base_addr memory base address
  * @param offset memory offset (bytes)
  * @param e endianness
  * @param f format
- * @return shared pointer that holds a MemoryFormatter instance
+ * @return MemoryFormatter instance
  */
-static std::shared_ptr<MemoryFormatter> get_formatter_64(void *base_addr, std::size_t offset, endianness e, format f) {
+template <typename Maker>
+static typename Maker::result_type
+        get_formatter_64(const Maker &maker, void *base_addr, std::size_t offset, endianness e, format f) {
     switch (f) {
-        case format::BIN: return std::make_shared<MemoryFormatter_Bit_64_Bin>(base_addr, offset, e);
-        case format::HEX: return std::make_shared<MemoryFormatter_Bit_64_Hex>(base_addr, offset, e);
-        case format::OCT: return std::make_shared<MemoryFormatter_Bit_64_Oct>(base_addr, offset, e);
-        case format::SIGNED: return std::make_shared<MemoryFormatter_Bit_64_Signed>(base_addr, offset, e);
-        case format::UNSIGNED: return std::make_shared<MemoryFormatter_Bit_64_Unsigned>(base_addr, offset, e);
-        case format::FLOAT: return std::make_shared<MemoryFormatter_Bit_64_Float>(base_addr, offset, e);
+        case format::BIN: return maker.template make<MemoryFormatter_Bit_64_Bin>(base_addr, offset, e);
+        case format::HEX: return maker.template make<MemoryFormatter_Bit_64_Hex>(base_addr, offset, e);
+        case format::OCT: return maker.template make<MemoryFormatter_Bit_64_Oct>(base_addr, offset, e);
+        case format::SIGNED: return maker.template make<MemoryFormatter_Bit_64_Signed>(base_addr, offset, e);
+        case format::UNSIGNED: return maker.template make<MemoryFormatter_Bit_64_Unsigned>(base_addr, offset, e);
+        case format::FLOAT: return maker.template make<MemoryFormatter_Bit_64_Float>(base_addr, offset, e);
+        case format::LABEL: throw std::invalid_argument("Format LABEL requires a label table");
+        case format::STRING: throw std::invalid_argument("Format STRING requires a field length");
     }
 }
 
@@ -459,8 +639,7 @@ static std::size_t get_address_from_string(const std::string &addr_string) {
     return addr_offset;
 }
 
-std::shared_ptr<MemoryFormatter> MemoryFormatter::get_formatter(
-        void *base_addr, const std::string &addr_string, wordsize w, format f, endianness e) {
+void detail::parse_address(const std::string &addr_string, wordsize w, std::size_t &offset, std::size_t &bit_index) {
     switch (w) {
         case wordsize::BIT_1: {
             const auto split_address = split_string(addr_string, '.', 1);
@@ -502,15 +681,86 @@ std::shared_ptr<MemoryFormatter> MemoryFormatter::get_formatter(
                 throw std::invalid_argument(error_msg.str());
             }
 
-            if (bit_offset > 7) throw std::out_of_range("bit index out of range (0..7)");
-
-            return std::make_shared<MemoryFormatter_Bit_1>(base_addr, addr_offset, bit_offset);
+            offset    = addr_offset;
+            bit_index = bit_offset;
+            break;
         }
-        case wordsize::BIT_8: return get_formatter_8(base_addr, get_address_from_string(addr_string), e, f);
-        case wordsize::BIT_16: return get_formatter_16(base_addr, get_address_from_string(addr_string), e, f);
-        case wordsize::BIT_32: return get_formatter_32(base_addr, get_address_from_string(addr_string), e, f);
-        case wordsize::BIT_64: return get_formatter_64(base_addr, get_address_from_string(addr_string), e, f);
+        case wordsize::BIT_8:
+        case wordsize::BIT_16:
+        case wordsize::BIT_32:
+        case wordsize::BIT_64: offset = get_address_from_string(addr_string); break;
     }
 }
 
+std::shared_ptr<MemoryFormatter> MemoryFormatter::get_formatter(
+        void *base_addr, const std::string &addr_string, wordsize w, format f, endianness e) {
+    std::size_t offset    = 0;
+    std::size_t bit_index = 0;
+    detail::parse_address(addr_string, w, offset, bit_index);
+    return get_formatter(base_addr, offset, w, f, e, bit_index);
+}
+
+FormatterHandle MemoryFormatter::get_formatter(std::pmr::memory_resource &resource,
+                                               void                      *base_addr,
+                                               const std::string         &addr_string,
+                                               wordsize                   w,
+                                               format                     f,
+                                               endianness                 e) {
+    std::size_t offset    = 0;
+    std::size_t bit_index = 0;
+    detail::parse_address(addr_string, w, offset, bit_index);
+    return get_formatter(resource, base_addr, offset, w, f, e, bit_index);
+}
+
+/**
+ * @brief create formatter
+ * @tparam Maker SharedMaker or ResourceMaker
+ * @param maker formatter factory
+ * @details see MemoryFormatter::get_formatter for a description of the other arguments
+ * @return MemoryFormatter instance
+ */
+template <typename Maker>
+static typename Maker::result_type create_formatter(const Maker &maker,
+                                                    void        *base_addr,
+                                                    std::size_t  offset,
+                                                    wordsize     w,
+                                                    format       f,
+                                                    endianness   e,
+                                                    std::size_t  bit_index) {
+    switch (w) {
+        case wordsize::BIT_1:
+            if (bit_index > 7) throw std::out_of_range("bit index out of range (0..7)");
+            return maker.template make<MemoryFormatter_Bit_1>(base_addr, offset, bit_index);
+        case wordsize::BIT_8: return get_formatter_8(maker, base_addr, offset, e, f);
+        case wordsize::BIT_16: return get_formatter_16(maker, base_addr, offset, e, f);
+        case wordsize::BIT_32: return get_formatter_32(maker, base_addr, offset, e, f);
+        case wordsize::BIT_64: return get_formatter_64(maker, base_addr, offset, e, f);
+    }
+}
+
+std::shared_ptr<MemoryFormatter> detail::new_formatter(
+        void *base_addr, std::size_t offset, wordsize w, format f, endianness e, std::size_t bit_index) {
+    return create_formatter(SharedMaker(), base_addr, offset, w, f, e, bit_index);
+}
+
+std::shared_ptr<MemoryFormatter> MemoryFormatter::get_formatter(
+        void *base_addr, std::size_t offset, wordsize w, format f, endianness e, std::size_t bit_index) {
+    return FormatterPool::global().get(base_addr, offset, w, f, e, bit_index);
+}
+
+FormatterHandle MemoryFormatter::get_formatter(std::pmr::memory_resource &resource,
+                                               void                      *base_addr,
+                                               std::size_t                offset,
+                                               wordsize                   w,
+                                               format                     f,
+                                               endianness                 e,
+                                               std::size_t                bit_index) {
+    return create_formatter(ResourceMaker {resource}, base_addr, offset, w, f, e, bit_index);
+}
+
+void FormatterDeleter::operator()(MemoryFormatter *formatter) const {
+    formatter->~MemoryFormatter();
+    resource->deallocate(formatter, size, alignment);
+}
+
 }  // namespace memformat
@@ -23,6 +23,11 @@ public:
 
     [[nodiscard]] std::string string() const override;
     [[nodiscard]] std::size_t max_offset() const override;
+    [[nodiscard]] std::size_t get_bit_index() const override { return bit_offset; }
+
+protected:
+    char         *format_value(volatile void *base, char *dest, memory_access access) const override;
+    std::uint64_t raw_value(volatile void *base, memory_access access) const override;
 };
 
 /**
@@ -30,9 +35,19 @@ public:
  */
 class MemoryFormatter_Bit_8 : public MemoryFormatter {
 protected:
-    MemoryFormatter_Bit_8(void *base_address, std::size_t offset, endianness endian);
+    MemoryFormatter_Bit_8(void *base_address, std::size_t offset, endianness endian, format f);
+
+    /**
+     * @brief read value
+     * @param base base memory address
+     * @param access memory access semantics
+     * @return value (host endianness)
+     */
+    [[nodiscard]] uint8_t get_data(volatile void *base, memory_access access) const;
 
-    [[nodiscard]] uint8_t get_data() const;
+    [[nodiscard]] uint8_t get_data() const { return get_data(base_address, memory_access::VOLATILE); }
+
+    std::uint64_t raw_value(volatile void *base, memory_access access) const override;
 
 public:
     [[nodiscard]] std::size_t max_offset() const override;
@@ -47,9 +62,22 @@ protected:
     //* function that handles the endianness conversion (set by constructor depending on value of endian)
     std::function<uint16_t(uint16_t)> convert_endianess;
 
-    MemoryFormatter_Bit_16(void *base_address, std::size_t offset, endianness endian);
+    //* base_address + offset is aligned for a native 16 bit load (classified by the constructor)
+    const bool aligned;
+
+    MemoryFormatter_Bit_16(void *base_address, std::size_t offset, endianness endian, format f);
 
-    [[nodiscard]] uint16_t get_data() const;
+    /**
+     * @brief read value
+     * @param base base memory address
+     * @param access memory access semantics
+     * @return value (host endianness)
+     */
+    [[nodiscard]] uint16_t get_data(volatile void *base, memory_access access) const;
+
+    [[nodiscard]] uint16_t get_data() const { return get_data(base_address, memory_access::VOLATILE); }
+
+    std::uint64_t raw_value(volatile void *base, memory_access access) const override;
 
 public:
     [[nodiscard]] std::size_t max_offset() const override;
@@ -64,9 +92,22 @@ protected:
     //* function that handles the endianness conversion (set by constructor depending on value of endian)
     std::function<uint32_t(uint32_t)> convert_endianess;
 
-    MemoryFormatter_Bit_32(void *base_address, std::size_t offset, endianness endian);
+    //* base_address + offset is aligned for a native 32 bit load (classified by the constructor)
+    const bool aligned;
+
+    MemoryFormatter_Bit_32(void *base_address, std::size_t offset, endianness endian, format f);
+
+    /**
+     * @brief read value
+     * @param base base memory address
+     * @param access memory access semantics
+     * @return value (host endianness)
+     */
+    [[nodiscard]] uint32_t get_data(volatile void *base, memory_access access) const;
 
-    [[nodiscard]] uint32_t get_data() const;
+    [[nodiscard]] uint32_t get_data() const { return get_data(base_address, memory_access::VOLATILE); }
+
+    std::uint64_t raw_value(volatile void *base, memory_access access) const override;
 
 public:
     [[nodiscard]] std::size_t max_offset() const override;
@@ -81,9 +122,22 @@ protected:
     //* function that handles the endianness conversion (set by constructor depending on value of endian)
     std::function<uint64_t(uint64_t)> convert_endianess;
 
-    MemoryFormatter_Bit_64(void *base_address, std::size_t offset, endianness endian);
+    //* base_address + offset is aligned for a native 64 bit load (classified by the constructor)
+    const bool aligned;
+
+    MemoryFormatter_Bit_64(void *base_address, std::size_t offset, endianness endian, format f);
+
+    /**
+     * @brief read value
+     * @param base base memory address
+     * @param access memory access semantics
+     * @return value (host endianness)
+     */
+    [[nodiscard]] uint64_t get_data(volatile void *base, memory_access access) const;
+
+    [[nodiscard]] uint64_t get_data() const { return get_data(base_address, memory_access::VOLATILE); }
 
-    [[nodiscard]] uint64_t get_data() const;
+    std::uint64_t raw_value(volatile void *base, memory_access access) const override;
 
 public:
     [[nodiscard]] std::size_t max_offset() const override;
@@ -98,6 +152,9 @@ public:
     MemoryFormatter_Bit_8_Bin(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -108,6 +165,9 @@ public:
     MemoryFormatter_Bit_8_Hex(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -118,6 +178,9 @@ public:
     MemoryFormatter_Bit_8_Oct(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -128,6 +191,9 @@ public:
     MemoryFormatter_Bit_8_Signed(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -138,6 +204,9 @@ public:
     MemoryFormatter_Bit_8_Unsigned(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -148,6 +217,9 @@ public:
     MemoryFormatter_Bit_16_Bin(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -158,6 +230,9 @@ public:
     MemoryFormatter_Bit_16_Hex(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -168,6 +243,9 @@ public:
     MemoryFormatter_Bit_16_Oct(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -178,6 +256,9 @@ public:
     MemoryFormatter_Bit_16_Signed(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -188,6 +269,9 @@ public:
     MemoryFormatter_Bit_16_Unsigned(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -198,6 +282,9 @@ public:
     MemoryFormatter_Bit_32_Bin(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -208,6 +295,9 @@ public:
     MemoryFormatter_Bit_32_Hex(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -218,6 +308,9 @@ public:
     MemoryFormatter_Bit_32_Oct(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -228,6 +321,9 @@ public:
     MemoryFormatter_Bit_32_Signed(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -238,6 +334,9 @@ public:
     MemoryFormatter_Bit_32_Unsigned(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -248,6 +347,9 @@ public:
     MemoryFormatter_Bit_32_Float(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -258,6 +360,9 @@ public:
     MemoryFormatter_Bit_64_Bin(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -268,6 +373,9 @@ public:
     MemoryFormatter_Bit_64_Hex(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -278,6 +386,9 @@ public:
     MemoryFormatter_Bit_64_Oct(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -288,6 +399,9 @@ public:
     MemoryFormatter_Bit_64_Signed(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -298,6 +412,9 @@ public:
     MemoryFormatter_Bit_64_Unsigned(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
 /**
@@ -308,6 +425,33 @@ public:
     MemoryFormatter_Bit_64_Float(void *base_address, std::size_t offset, endianness endian);
 
     [[nodiscard]] std::string string() const override;
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
 };
 
+namespace detail {
+
+/**
+ * @brief parse address string
+ * @param addr_string address string (see MemoryFormatter::get_formatter)
+ * @param w word size
+ * @param offset output: memory offset
+ * @param bit_index output: bit index (only set for word size BIT_1)
+ *
+ * @exception: std::invalid_argument failed to parse the address string
+ */
+void parse_address(const std::string &addr_string, wordsize w, std::size_t &offset, std::size_t &bit_index);
+
+/**
+ * @brief create a new formatter instance (not interned)
+ * @details used by the FormatterPool and for temporary formatters; see MemoryFormatter::get_formatter for a
+ *          description of the arguments and exceptions
+ * @return new formatter instance
+ */
+std::shared_ptr<MemoryFormatter>
+        new_formatter(void *base_addr, std::size_t offset, wordsize w, format f, endianness e, std::size_t bit_index);
+
+}  // namespace detail
+
 }  // namespace memformat
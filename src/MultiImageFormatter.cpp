@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "MultiImageFormatter.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace memformat {
+
+MultiImageFormatter::MultiImageFormatter(const FormatterSet &set)
+    : image_size(set.region().size), access(set.get_access()), first(set.duplicates()) {
+    formatters.reserve(set.size());
+    for (const auto &entry : set)
+        formatters.emplace_back(entry.formatter);
+
+    // the first entry of a shared instance gets a slot when its first duplicate is found
+    slots.assign(first.size(), NO_SLOT);
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        if (first[i] == i) continue;
+        auto &slot = slots[first[i]];
+        if (slot == NO_SLOT) slot = slot_count++;
+        slots[i] = slot;
+    }
+}
+
+void MultiImageFormatter::format(volatile void *const *images,
+                                 std::size_t           count,
+                                 const Callback       &callback,
+                                 order                 o,
+                                 unsigned              threads) const {
+    if (!callback) throw std::invalid_argument("callback must not be empty");
+
+    if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1U);
+    const auto chunks = std::min<std::size_t>(threads, count);
+
+    if (chunks <= 1) {
+        format_range(images, 0, count, callback, o);
+        return;
+    }
+
+    std::vector<std::exception_ptr> exceptions(chunks);
+    std::vector<std::thread>        workers;
+    workers.reserve(chunks - 1);
+
+    const auto run = [&](std::size_t chunk) {
+        try {
+            format_range(images, count * chunk / chunks, count * (chunk + 1) / chunks, callback, o);
+        } catch (...) {
+            exceptions[chunk] = std::current_exception();
+        }
+    };
+
+    // the calling thread formats the first chunk
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+        workers.emplace_back(run, chunk);
+    run(0);
+
+    for (auto &worker : workers)
+        worker.join();
+
+    for (const auto &exception : exceptions)
+        if (exception) std::rethrow_exception(exception);
+}
+
+void MultiImageFormatter::format_range(volatile void *const *images,
+                                       std::size_t           first_image,
+                                       std::size_t           last_image,
+                                       const Callback       &callback,
+                                       order                 o) const {
+    char buffer[MAX_STRING_LENGTH];
+
+    // outputs of the shared formatter instances: the values of the current image (IMAGE_MAJOR) or of all images of
+    // the range (LAYOUT_MAJOR), ends[k] is the end of the k-th value in text
+    struct SharedValues {
+        std::string              text;
+        std::vector<std::size_t> ends;
+    };
+    std::vector<SharedValues> shared(slot_count);
+
+    // k: position of the value in the shared outputs
+    const auto format_one = [&](std::size_t image, std::size_t index, std::size_t k) {
+        const auto slot = slots[index];
+        if (slot == NO_SLOT) {
+            const auto end = formatters[index]->format_to(images[image], buffer, access);
+            callback(image, index, std::string_view(buffer, static_cast<std::size_t>(end - buffer)));
+            return;
+        }
+
+        auto &values = shared[slot];
+        if (first[index] == index) {
+            if (k == 0) {
+                values.text.clear();
+                values.ends.clear();
+            }
+            const auto end = formatters[index]->format_to(images[image], buffer, access);
+            values.text.append(buffer, end);
+            values.ends.push_back(values.text.size());
+        }
+
+        const auto begin = k ? values.ends[k - 1] : 0;
+        callback(image, index, std::string_view(values.text).substr(begin, values.ends[k] - begin));
+    };
+
+    switch (o) {
+        case order::IMAGE_MAJOR:
+            for (std::size_t image = first_image; image < last_image; ++image)
+                for (std::size_t index = 0; index < formatters.size(); ++index)
+                    format_one(image, index, 0);
+            break;
+        case order::LAYOUT_MAJOR:
+            for (std::size_t index = 0; index < formatters.size(); ++index)
+                for (std::size_t image = first_image; image < last_image; ++image)
+                    format_one(image, index, image - first_image);
+            break;
+    }
+}
+
+}  // namespace memformat
@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace memformat {
+
+/**
+ * @brief type of the output of a formatter
+ */
+enum class value_kind {
+    BIT,       //*< single bit (0/1)
+    SIGNED,    //*< signed decimal number
+    UNSIGNED,  //*< unsigned decimal number
+    FLOAT,     //*< floating point number (might be nan/inf)
+    DIGITS,    //*< binary, octal or hexadecimal digits (string that never requires escaping)
+    TEXT,      //*< arbitrary text (labels and character fields)
+};
+
+/**
+ * @brief get output type of a formatter
+ * @param formatter formatter
+ * @return output type
+ */
+static value_kind get_value_kind(const MemoryFormatter &formatter) {
+    if (formatter.get_wordsize() == wordsize::BIT_1) return value_kind::BIT;
+
+    switch (formatter.get_format()) {
+        case format::SIGNED: return value_kind::SIGNED;
+        case format::UNSIGNED: return value_kind::UNSIGNED;
+        case format::FLOAT: return value_kind::FLOAT;
+        case format::BIN:
+        case format::OCT:
+        case format::HEX: return value_kind::DIGITS;
+        case format::LABEL:
+        case format::STRING: return value_kind::TEXT;
+    }
+
+    return value_kind::TEXT;
+}
+
+/**
+ * @brief check whether the output of a float formatter is a finite number
+ * @param first first character
+ * @param last pointer behind the last character
+ * @return true if the output is finite (does not end with "nan" or "inf")
+ */
+static bool is_finite_output(const char *first, const char *last) {
+    return last != first && last[-1] >= '0' && last[-1] <= '9';
+}
+
+/**
+ * @brief append string as JSON string (including quotes)
+ * @param out output string
+ * @param str string to escape
+ */
+static void append_json_string(std::string &out, std::string_view str) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    out.push_back('"');
+    for (const char c : str) {
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out.append("\\u00");
+                    out.push_back(HEX_DIGITS[(static_cast<unsigned char>(c) >> 4) & 0xF]);
+                    out.push_back(HEX_DIGITS[static_cast<unsigned char>(c) & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+/**
+ * @brief append value of a formatter as JSON value
+ * @param out output string
+ * @param formatter formatter
+ * @param base base address the value is read from
+ * @param access memory access semantics
+ */
+static void append_json_value(std::string           &out,
+                              const MemoryFormatter &formatter,
+                              volatile void         *base,
+                              memory_access          access) {
+    char       value[MAX_STRING_LENGTH];
+    const auto end = formatter.format_to(base, value, access);
+
+    switch (get_value_kind(formatter)) {
+        case value_kind::FLOAT:
+            if (!is_finite_output(value, end)) {
+                out.append("null");
+                break;
+            }
+            out.append(value, end);
+            break;
+        case value_kind::BIT:
+        case value_kind::SIGNED:
+        case value_kind::UNSIGNED: out.append(value, end); break;
+        case value_kind::DIGITS:
+            out.push_back('"');
+            out.append(value, end);
+            out.push_back('"');
+            break;
+        case value_kind::TEXT:
+            append_json_string(out, std::string_view(value, static_cast<std::size_t>(end - value)));
+            break;
+    }
+}
+
+/**
+ * @brief append string with InfluxDB line protocol escaping
+ * @param out output string
+ * @param str string to escape
+ * @param special characters that have to be escaped (in addition to the backslash)
+ */
+static void append_line_protocol_escaped(std::string &out, std::string_view str, const char *special) {
+    for (const char c : str) {
+        if (c == '\\') {
+            out.append("\\\\");
+            continue;
+        }
+
+        for (const char *s = special; *s; ++s) {
+            if (c == *s) {
+                out.push_back('\\');
+                break;
+            }
+        }
+        out.push_back(c);
+    }
+}
+
+/**
+ * @brief position of a formatted value in the output string
+ */
+struct ValueSpan {
+    std::size_t start;   //*< index of the first character (SKIPPED: the value was not written)
+    std::size_t length;  //*< number of characters
+
+    //* start of a value that was not written
+    static constexpr std::size_t SKIPPED = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * @brief get the value positions of the calling thread
+ * @details The buffer is shared by all sinks of a thread: no memory is allocated once it has grown to the size of the
+ *          largest formatter set.
+ * @param size number of values
+ * @return value positions (at least size elements)
+ */
+static std::vector<ValueSpan> &value_spans(std::size_t size) {
+    thread_local std::vector<ValueSpan> spans;
+    if (spans.size() < size) spans.resize(size);
+    return spans;
+}
+
+/**
+ * @brief append a value once per formatter instance
+ * @details The value of an entry that shares the formatter instance of a previous entry is copied from the output of
+ *          the previous entry instead of being formatted again.
+ * @param out output string
+ * @param spans value positions (updated)
+ * @param first index of the first entry with the same formatter instance (see FormatterSet::duplicates)
+ * @param i entry index
+ * @param append function that formats and appends the value
+ */
+template <typename Append>
+static void append_once(std::string                    &out,
+                        std::vector<ValueSpan>         &spans,
+                        const std::vector<std::size_t> &first,
+                        std::size_t                     i,
+                        const Append                   &append) {
+    const auto start = out.size();
+    if (first[i] == i) {
+        append();
+    } else {
+        const auto &shared = spans[first[i]];
+        out.append(out, shared.start, shared.length);
+    }
+    spans[i] = {start, out.size() - start};
+}
+
+OutputSink::OutputSink(const FormatterSet &set) : access(set.get_access()), first(set.duplicates()) {
+    // all formatters share a single base address
+    (void) set.region();
+
+    formatters.reserve(set.size());
+    for (const auto &entry : set)
+        formatters.emplace_back(entry.formatter);
+}
+
+const std::string &OutputSink::render() {
+    buffer.clear();
+    render_to(buffer);
+    return buffer;
+}
+
+const std::string &OutputSink::render_region(volatile void *base) {
+    buffer.clear();
+    render_region_to(buffer, base);
+    return buffer;
+}
+
+JsonObjectSink::JsonObjectSink(const FormatterSet &set) : OutputSink(set) {
+    prefixes.reserve(set.size());
+    for (const auto &entry : set) {
+        std::string prefix(prefixes.empty() ? "{" : ",");
+        append_json_string(prefix, entry.name);
+        prefix.push_back(':');
+        prefixes.emplace_back(std::move(prefix));
+    }
+}
+
+void JsonObjectSink::render_region_to(std::string &out, volatile void *base) const {
+    if (formatters.empty()) {
+        out.append("{}");
+        return;
+    }
+
+    auto &spans = value_spans(formatters.size());
+    for (std::size_t i = 0; i < formatters.size(); ++i) {
+        out.append(prefixes[i]);
+        append_once(out, spans, first, i, [&] { append_json_value(out, *formatters[i], base_of(i, base), access); });
+    }
+    out.push_back('}');
+}
+
+JsonArraySink::JsonArraySink(const FormatterSet &set) : OutputSink(set) {}
+
+void JsonArraySink::render_region_to(std::string &out, volatile void *base) const {
+    out.push_back('[');
+    auto &spans = value_spans(formatters.size());
+    for (std::size_t i = 0; i < formatters.size(); ++i) {
+        if (i) out.push_back(',');
+        append_once(out, spans, first, i, [&] { append_json_value(out, *formatters[i], base_of(i, base), access); });
+    }
+    out.push_back(']');
+}
+
+/**
+ * @brief append a CSV field
+ * @details The field is quoted (quotes are doubled) if it contains the delimiter, a quote or a line break.
+ * @param out output string
+ * @param field field content
+ * @param delimiter field delimiter
+ */
+static void append_csv_field(std::string &out, std::string_view field, char delimiter) {
+    const char special[] = {'"', '\r', '\n', delimiter, '\0'};
+    if (field.find_first_of(special) == std::string_view::npos) {
+        out.append(field);
+        return;
+    }
+
+    out.push_back('"');
+    for (const char c : field) {
+        if (c == '"') out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+CsvRowSink::CsvRowSink(const FormatterSet &set, char delimiter) : OutputSink(set), delimiter(delimiter) {
+    for (const auto &entry : set) {
+        if (!header_row.empty()) header_row.push_back(delimiter);
+        append_csv_field(header_row, entry.name, delimiter);
+    }
+    header_row.push_back('\n');
+}
+
+void CsvRowSink::render_region_to(std::string &out, volatile void *base) const {
+    auto &spans = value_spans(formatters.size());
+    for (std::size_t i = 0; i < formatters.size(); ++i) {
+        if (i) out.push_back(delimiter);
+
+        append_once(out, spans, first, i, [&] {
+            const auto &formatter = *formatters[i];
+            if (get_value_kind(formatter) != value_kind::TEXT) {
+                formatter.append_to(base_of(i, base), out, access);
+                return;
+            }
+
+            // labels may contain the delimiter
+            char       value[MAX_STRING_LENGTH];
+            const auto end = formatter.format_to(base_of(i, base), value, access);
+            append_csv_field(out, std::string_view(value, static_cast<std::size_t>(end - value)), delimiter);
+        });
+    }
+    out.push_back('\n');
+}
+
+LineProtocolSink::LineProtocolSink(const FormatterSet                                     &set,
+                                   const std::string                                      &measurement,
+                                   const std::vector<std::pair<std::string, std::string>> &tags)
+    : OutputSink(set) {
+    if (measurement.empty()) throw std::invalid_argument("measurement name must not be empty");
+    if (set.size() == 0) throw std::invalid_argument("line protocol requires at least one field");
+
+    append_line_protocol_escaped(line_prefix, measurement, ", ");
+    for (const auto &[key, value] : tags) {
+        line_prefix.push_back(',');
+        append_line_protocol_escaped(line_prefix, key, ",= ");
+        line_prefix.push_back('=');
+        append_line_protocol_escaped(line_prefix, value, ",= ");
+    }
+    line_prefix.push_back(' ');
+
+    field_prefixes.reserve(set.size());
+    for (const auto &entry : set) {
+        std::string prefix;
+        append_line_protocol_escaped(prefix, entry.name, ",= ");
+        prefix.push_back('=');
+        field_prefixes.emplace_back(std::move(prefix));
+    }
+}
+
+void LineProtocolSink::render_region_to(std::string &out, volatile void *base) const {
+    const auto start = out.size();
+    out.append(line_prefix);
+
+    auto &spans       = value_spans(formatters.size());
+    bool  first_field = true;
+    for (std::size_t i = 0; i < formatters.size(); ++i) {
+        // shared formatter instance: copy the value of the previous entry (skipped if it was skipped)
+        if (first[i] != i) {
+            const auto shared = spans[first[i]];
+            spans[i]          = shared;
+            if (shared.start == ValueSpan::SKIPPED) continue;
+
+            if (!first_field) out.push_back(',');
+            first_field = false;
+            out.append(field_prefixes[i]);
+            spans[i].start = out.size();
+            out.append(out, shared.start, shared.length);
+            continue;
+        }
+
+        const auto &formatter = *formatters[i];
+
+        char       value[MAX_STRING_LENGTH];
+        const auto end  = formatter.format_to(base_of(i, base), value, access);
+        const auto kind = get_value_kind(formatter);
+
+        if (kind == value_kind::FLOAT && !is_finite_output(value, end)) {
+            spans[i] = {ValueSpan::SKIPPED, 0};
+            continue;
+        }
+
+        if (!first_field) out.push_back(',');
+        first_field = false;
+        out.append(field_prefixes[i]);
+        const auto value_start = out.size();
+
+        switch (kind) {
+            case value_kind::BIT: out.append(*value == '1' ? "true" : "false"); break;
+            case value_kind::SIGNED:
+                out.append(value, end);
+                out.push_back('i');
+                break;
+            case value_kind::UNSIGNED:
+                out.append(value, end);
+                out.push_back('u');
+                break;
+            case value_kind::FLOAT: out.append(value, end); break;
+            case value_kind::DIGITS:
+                out.push_back('"');
+                out.append(value, end);
+                out.push_back('"');
+                break;
+            case value_kind::TEXT:
+                out.push_back('"');
+                append_line_protocol_escaped(out, std::string_view(value, static_cast<std::size_t>(end - value)), "\"");
+                out.push_back('"');
+                break;
+        }
+        spans[i] = {value_start, out.size() - value_start};
+    }
+
+    // a line without fields is invalid
+    if (first_field) {
+        out.resize(start);
+        return;
+    }
+
+    out.push_back('\n');
+}
+
+void LineProtocolSink::render_to(std::string &out, std::int64_t timestamp) const {
+    const auto start = out.size();
+    render_to(out);
+    if (out.size() == start) return;
+    out.back() = ' ';
+
+    char timestamp_str[MAX_STRING_LENGTH];
+    out.append(timestamp_str, detail::int_to_chars(timestamp_str, timestamp));
+    out.push_back('\n');
+}
+
+const std::string &LineProtocolSink::render(std::int64_t timestamp) {
+    buffer.clear();
+    render_to(buffer, timestamp);
+    return buffer;
+}
+
+}  // namespace memformat
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_LINUX
+
+#    include "ProcessReader.hpp"
+
+#    include <algorithm>
+#    include <cerrno>
+#    include <stdexcept>
+#    include <system_error>
+
+namespace memformat {
+
+//* maximum number of io vectors per system call (IOV_MAX on Linux)
+static constexpr std::size_t MAX_IOV = 1024;
+
+/**
+ * @brief create read plan
+ * @param set formatters
+ * @param max_gap maximum gap within a range
+ * @return read plan
+ */
+static ReadPlan make_plan(const FormatterSet &set, std::size_t max_gap) {
+    if (set.empty()) throw std::invalid_argument("formatter set is empty");
+    return ReadPlan(set, max_gap);
+}
+
+ProcessReader::ProcessReader(pid_t pid, const FormatterSet &set, std::size_t max_gap)
+    : pid(pid), plan(make_plan(set, max_gap)), buffer(plan.buffer_size()), local_set(plan.bind(buffer.data())) {
+    local_iov.reserve(plan.ranges().size());
+    remote_iov.reserve(plan.ranges().size());
+    for (const auto &range : plan.ranges()) {
+        local_iov.push_back({buffer.data() + range.buffer_offset, range.size});
+        remote_iov.push_back({reinterpret_cast<void *>(range.address), range.size});
+    }
+}
+
+void ProcessReader::read() {
+    for (std::size_t first = 0; first < local_iov.size(); first += MAX_IOV) {
+        const auto count = std::min(MAX_IOV, local_iov.size() - first);
+
+        std::size_t expected = 0;
+        for (std::size_t i = first; i < first + count; ++i)
+            expected += local_iov[i].iov_len;
+
+        const auto result = ::process_vm_readv(pid, &local_iov[first], count, &remote_iov[first], count, 0);
+        if (result < 0) throw std::system_error(errno, std::generic_category(), "process_vm_readv");
+
+        // partial transfers stop at the first range that could not be read
+        if (static_cast<std::size_t>(result) != expected)
+            throw std::system_error(EFAULT, std::generic_category(), "process_vm_readv: partial read");
+    }
+}
+
+}  // namespace memformat
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "ReadPlan.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace memformat {
+
+ReadPlan::ReadPlan(const FormatterSet &set, std::size_t max_gap) {
+    // [first, last] address of each value
+    std::vector<std::uintptr_t> first(set.size());
+    std::vector<std::uintptr_t> last(set.size());
+
+    duplicate_of = set.duplicates();
+    prototypes.reserve(set.size());
+    names.reserve(set.size());
+    for (std::size_t i = 0; i < set.size(); ++i) {
+        const auto &f    = *set[i].formatter;
+        const auto  base = reinterpret_cast<std::uintptr_t>(f.get_base_address());
+        first[i]         = base + f.get_offset();
+        last[i]          = base + f.max_offset();
+
+        prototypes.push_back(duplicate_of[i] == i ? f.relocate(nullptr, 0) : nullptr);
+        names.push_back(set[i].name);
+    }
+
+    std::vector<std::size_t> order(set.size());
+    std::iota(order.begin(), order.end(), std::size_t {0});
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return first[a] < first[b]; });
+
+    // merge the values into ranges
+    value_offsets.resize(set.size());
+    std::size_t used = 0;  // bytes that are read by at least one formatter
+    for (const auto i : order) {
+        if (!plan_ranges.empty()) {
+            auto      &range = plan_ranges.back();
+            const auto end   = range.address + range.size;  // behind the last byte of the range
+
+            if (first[i] <= end || first[i] - end <= max_gap) {
+                if (last[i] >= end) {
+                    used += last[i] + 1 - std::max(first[i], end);
+                    range.size = last[i] + 1 - range.address;
+                }
+                value_offsets[i] = range.buffer_offset + (first[i] - range.address);
+                continue;
+            }
+
+            total_size += range.size;
+        }
+
+        plan_ranges.push_back({first[i], last[i] - first[i] + 1, total_size});
+        value_offsets[i] = total_size;
+        used += last[i] - first[i] + 1;
+    }
+    if (!plan_ranges.empty()) total_size += plan_ranges.back().size;
+
+    gap_size = total_size - used;
+}
+
+void ReadPlan::copy(void *buffer) const {
+    auto *dest = static_cast<std::byte *>(buffer);
+    for (const auto &range : plan_ranges)
+        std::memcpy(dest + range.buffer_offset, reinterpret_cast<const void *>(range.address), range.size);
+}
+
+FormatterSet ReadPlan::bind(void *buffer) const {
+    auto *data = static_cast<std::byte *>(buffer);
+
+    FormatterSet result;
+    for (std::size_t i = 0; i < prototypes.size(); ++i) {
+        const auto first = duplicate_of[i];
+        result.add(names[i],
+                   first == i ? prototypes[i]->relocate(data, value_offsets[i]) : result[first].formatter);
+    }
+    result.set_access(memory_access::PLAIN);
+    return result;
+}
+
+}  // namespace memformat
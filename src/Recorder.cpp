@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_POSIX
+
+#    include "Recorder.hpp"
+
+#    include "recording.hpp"
+
+#    include <cerrno>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <stdexcept>
+#    include <system_error>
+#    include <unistd.h>
+
+namespace memformat {
+
+/**
+ * @brief write the complete buffer to a file descriptor
+ * @param fd file descriptor
+ * @param data data
+ * @param size number of bytes
+ */
+static void write_all(int fd, const std::byte *data, std::size_t size) {
+    while (size) {
+        const auto result = ::write(fd, data, size);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+        data += result;
+        size -= static_cast<std::size_t>(result);
+    }
+}
+
+Recorder::Recorder(const std::string  &path,
+                   const FormatterSet &set,
+                   std::size_t         keyframe_interval,
+                   std::size_t         buffer_size)
+    : region(set.region()), keyframe_interval(keyframe_interval), buffer_size(buffer_size) {
+    if (set.empty()) throw std::invalid_argument("formatter set is empty");
+    if (keyframe_interval == 0 || keyframe_interval > UINT32_MAX)
+        throw std::invalid_argument("invalid keyframe interval");
+    if (region.size > UINT32_MAX / 2) throw std::invalid_argument("memory region too large");
+
+    previous.resize(region.size);
+    current.resize(region.size);
+    buffer.reserve(buffer_size + sizeof(detail::RecordHeader) + 2 * region.size);
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "failed to open " + path);
+
+    detail::RecordingHeader header {};
+    std::memcpy(header.magic, detail::RECORDING_MAGIC, sizeof(header.magic));
+    header.version            = detail::RECORDING_VERSION;
+    header.byte_order         = detail::RECORDING_BYTE_ORDER;
+    header.region_size        = region.size;
+    header.keyframe_interval  = static_cast<std::uint32_t>(keyframe_interval);
+    header.record_header_size = sizeof(detail::RecordHeader);
+
+    buffer.resize(sizeof(header));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+}
+
+Recorder::~Recorder() {
+    try {
+        flush();
+    } catch (const std::exception &) {
+        // errors are ignored
+    }
+    ::close(fd);
+}
+
+void Recorder::record(std::chrono::system_clock::time_point timestamp) {
+    std::memcpy(current.data(), const_cast<const void *>(region.address), region.size);
+    encode(current.data(), timestamp);
+}
+
+void Recorder::record(const void *data, std::chrono::system_clock::time_point timestamp) {
+    encode(static_cast<const std::byte *>(data), timestamp);
+}
+
+void Recorder::flush() {
+    write_all(fd, buffer.data(), buffer.size());
+    total_written += buffer.size();
+    buffer.clear();
+}
+
+void Recorder::encode(const std::byte *data, std::chrono::system_clock::time_point timestamp) {
+    const auto record_offset  = buffer.size();
+    const auto payload_offset = record_offset + sizeof(detail::RecordHeader);
+    buffer.resize(payload_offset);
+
+    detail::RecordHeader header {};
+    header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+    header.sequence  = frame_count;
+
+    bool keyframe = frame_count % keyframe_interval == 0;
+    if (!keyframe) {
+        detail::encode_delta(previous.data(), data, region.size, buffer);
+
+        // store a keyframe if the delta is not smaller than the frame
+        keyframe = buffer.size() - payload_offset >= region.size;
+    }
+
+    if (keyframe) {
+        buffer.resize(payload_offset);
+        buffer.insert(buffer.end(), data, data + region.size);
+        header.flags = detail::RECORD_KEYFRAME;
+    }
+
+    header.size = static_cast<std::uint32_t>(buffer.size() - record_offset);
+    std::memcpy(buffer.data() + record_offset, &header, sizeof(header));
+
+    std::memcpy(previous.data(), data, region.size);
+    ++frame_count;
+
+    if (buffer.size() >= buffer_size) flush();
+}
+
+}  // namespace memformat
+
+#endif
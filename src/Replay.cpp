@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_POSIX
+
+#    include "Replay.hpp"
+
+#    include "recording.hpp"
+
+#    include <algorithm>
+#    include <cerrno>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <stdexcept>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <system_error>
+#    include <unistd.h>
+
+namespace memformat {
+
+/**
+ * @brief map a file into memory (read only)
+ * @param path file
+ * @param size output: file size
+ * @return mapped file
+ */
+static const std::byte *map_file(const std::string &path, std::size_t &size) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "failed to open " + path);
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(detail::RecordingHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path + " is not a valid recording");
+    }
+
+    void      *addr  = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto error = errno;
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::system_error(error, std::generic_category(), "mmap");
+
+    return static_cast<const std::byte *>(addr);
+}
+
+/**
+ * @brief convert recorded timestamp to time point
+ * @param ns nanoseconds since the epoch of the system clock
+ * @return time point
+ */
+static std::chrono::system_clock::time_point to_time_point(std::int64_t ns) {
+    return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+Replay::Replay(const std::string &path, const FormatterSet &set) {
+    file = map_file(path, file_size);
+
+    try {
+        detail::RecordingHeader header {};
+        std::memcpy(&header, file, sizeof(header));
+        if (std::memcmp(header.magic, detail::RECORDING_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != detail::RECORDING_VERSION || header.byte_order != detail::RECORDING_BYTE_ORDER ||
+            header.record_header_size != sizeof(detail::RecordHeader))
+            throw std::runtime_error(path + " is not a valid recording");
+
+        region_size = header.region_size;
+        if (set.region().size != region_size)
+            throw std::invalid_argument("memory region of the formatter set does not match the recording");
+
+        // build the frame index (stops at a truncated record)
+        std::size_t offset   = sizeof(header);
+        std::size_t keyframe = 0;
+        while (file_size - offset >= sizeof(detail::RecordHeader)) {
+            detail::RecordHeader record {};
+            std::memcpy(&record, file + offset, sizeof(record));
+            if (record.size < sizeof(record) || record.size > file_size - offset) break;
+
+            if (record.flags & detail::RECORD_KEYFRAME) {
+                if (record.size - sizeof(record) != region_size) throw std::runtime_error("corrupt keyframe");
+                keyframe = index.size();
+            } else if (index.empty()) {
+                throw std::runtime_error("recording does not start with a keyframe");
+            }
+
+            index.push_back({offset, keyframe});
+            infos.push_back({record.sequence, to_time_point(record.timestamp)});
+            offset += record.size;
+        }
+    } catch (...) {
+        munmap(const_cast<std::byte *>(file), file_size);
+        throw;
+    }
+
+    frame.resize(region_size);
+    loaded           = infos.size();
+    frame_formatters = set.rebind(frame.data());
+}
+
+Replay::~Replay() { munmap(const_cast<std::byte *>(file), file_size); }
+
+std::size_t Replay::find(std::chrono::system_clock::time_point timestamp) const {
+    const auto it = std::upper_bound(
+            infos.begin(), infos.end(), timestamp, [](auto t, const FrameInfo &info) { return t < info.timestamp; });
+    if (it == infos.begin()) throw std::out_of_range("no frame at or before the given time");
+    return static_cast<std::size_t>(it - infos.begin()) - 1;
+}
+
+const FormatterSet &Replay::load(std::size_t i) {
+    if (i >= infos.size()) throw std::out_of_range("frame index out of range");
+
+    if (loaded == i) return frame_formatters;
+
+    // continue from the decoded frame if there is no keyframe in between
+    auto first = index[i].keyframe;
+    if (loaded < i && loaded >= first) first = loaded + 1;
+
+    for (auto n = first; n <= i; ++n) {
+        detail::RecordHeader record {};
+        std::memcpy(&record, file + index[n].offset, sizeof(record));
+        const auto *payload = file + index[n].offset + sizeof(record);
+        const auto *end     = file + index[n].offset + record.size;
+
+        if (record.flags & detail::RECORD_KEYFRAME) {
+            std::memcpy(frame.data(), payload, region_size);
+        } else if (!detail::apply_delta(payload, end, frame.data(), region_size)) {
+            loaded = infos.size();
+            throw std::runtime_error("corrupt frame");
+        }
+        loaded = n;
+    }
+
+    return frame_formatters;
+}
+
+}  // namespace memformat
+
+#endif
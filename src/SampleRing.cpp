@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "SampleRing.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace memformat {
+
+SampleRing::SampleRing(const FormatterSet &set, std::size_t capacity)
+    : region(set.region()),
+      capacity(capacity),
+      slot_stride(((region.size + CACHE_LINE - 1) / CACHE_LINE) * CACHE_LINE) {
+    if (set.empty()) throw std::invalid_argument("formatter set is empty");
+    if (capacity == 0) throw std::invalid_argument("capacity must not be 0");
+
+    storage.resize(capacity * slot_stride);
+    sequences.resize(capacity);
+    timestamps.resize(capacity);
+
+    samples = set.rebind(storage.data());
+}
+
+std::byte *SampleRing::producer_slot() {
+    const auto head = producer_state.head.load(std::memory_order_relaxed);
+
+    if (head - producer_state.cached_tail == capacity) {
+        producer_state.cached_tail = consumer_state.tail.load(std::memory_order_acquire);
+        if (head - producer_state.cached_tail == capacity) {
+            ++producer_state.produced;
+            producer_state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    return storage.data() + (head % capacity) * slot_stride;
+}
+
+void SampleRing::producer_commit(std::chrono::system_clock::time_point timestamp) {
+    const auto head  = producer_state.head.load(std::memory_order_relaxed);
+    const auto index = head % capacity;
+
+    sequences[index]  = producer_state.produced++;
+    timestamps[index] = timestamp;
+    producer_state.head.store(head + 1, std::memory_order_release);
+}
+
+bool SampleRing::capture(std::chrono::system_clock::time_point timestamp) {
+    auto *slot = producer_slot();
+    if (!slot) return false;
+
+    std::memcpy(slot, const_cast<const void *>(region.address), region.size);
+    producer_commit(timestamp);
+    return true;
+}
+
+bool SampleRing::push(const void *data, std::chrono::system_clock::time_point timestamp) {
+    auto *slot = producer_slot();
+    if (!slot) return false;
+
+    std::memcpy(slot, data, region.size);
+    producer_commit(timestamp);
+    return true;
+}
+
+const SampleRing::Sample *SampleRing::front() {
+    const auto tail = consumer_state.tail.load(std::memory_order_relaxed);
+
+    if (tail == consumer_state.cached_head) {
+        consumer_state.cached_head = producer_state.head.load(std::memory_order_acquire);
+        if (tail == consumer_state.cached_head) return nullptr;
+    }
+
+    const auto index  = tail % capacity;
+    auto      &sample = consumer_state.front_sample;
+    sample.sequence   = sequences[index];
+    sample.timestamp  = timestamps[index];
+    sample.data       = storage.data() + index * slot_stride;
+    sample.size       = region.size;
+    return &sample;
+}
+
+void SampleRing::pop() {
+    const auto tail = consumer_state.tail.load(std::memory_order_relaxed);
+    consumer_state.tail.store(tail + 1, std::memory_order_release);
+}
+
+std::size_t SampleRing::consume(const Consumer &consumer, std::size_t max) {
+    std::size_t count = 0;
+    while (count < max) {
+        const auto *sample = front();
+        if (!sample) break;
+
+        consumer(*sample);
+        pop();
+        ++count;
+    }
+    return count;
+}
+
+std::size_t SampleRing::size() const {
+    const auto tail = consumer_state.tail.load(std::memory_order_acquire);
+    const auto head = producer_state.head.load(std::memory_order_acquire);
+    return head - tail;
+}
+
+}  // namespace memformat
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_POSIX
+
+#    include "Sampler.hpp"
+
+#    include <cerrno>
+#    include <cstring>
+#    include <ctime>
+#    include <future>
+#    include <pthread.h>
+#    include <stdexcept>
+#    include <system_error>
+
+namespace memformat {
+
+static constexpr std::int64_t NS_PER_S = 1000000000;
+
+/**
+ * @brief convert timespec to nanoseconds
+ * @param ts timespec
+ * @return nanoseconds
+ */
+static std::int64_t to_ns(const timespec &ts) { return static_cast<std::int64_t>(ts.tv_sec) * NS_PER_S + ts.tv_nsec; }
+
+/**
+ * @brief convert nanoseconds to timespec
+ * @param ns nanoseconds
+ * @return timespec
+ */
+static timespec to_timespec(std::int64_t ns) {
+    timespec ts {};
+    ts.tv_sec  = ns / NS_PER_S;
+    ts.tv_nsec = ns % NS_PER_S;
+    return ts;
+}
+
+/**
+ * @brief get current time of the monotonic clock
+ * @return nanoseconds
+ */
+static std::int64_t monotonic_now() {
+    timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return to_ns(ts);
+}
+
+/**
+ * @brief update maximum value
+ * @param max atomic maximum
+ * @param value new value
+ */
+static void update_max(std::atomic<std::int64_t> &max, std::int64_t value) {
+    auto current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief pin the calling thread to a cpu
+ * @param cpu cpu index (-1: no pinning)
+ * @return 0 on success, otherwise an error number
+ */
+static int pin_current_thread(int cpu) {
+    if (cpu < 0) return 0;
+
+#    ifdef OS_LINUX
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(static_cast<std::size_t>(cpu), &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#    else
+    return ENOTSUP;
+#    endif
+}
+
+Sampler::Sampler(const FormatterSet &set, std::chrono::nanoseconds period, Callback callback, int cpu)
+    : region(set.region()), snapshot(region.size), period(period), callback(std::move(callback)), cpu(cpu) {
+    if (set.empty()) throw std::invalid_argument("formatter set is empty");
+    if (period.count() <= 0) throw std::invalid_argument("period must be positive");
+    if (!this->callback) throw std::invalid_argument("callback is empty");
+
+    snapshot_formatters = set.rebind(snapshot.data());
+}
+
+Sampler::Sampler(SampleRing &ring, std::chrono::nanoseconds period, int cpu)
+    : region(ring.get_region()), period(period), cpu(cpu), ring(&ring) {
+    if (period.count() <= 0) throw std::invalid_argument("period must be positive");
+}
+
+Sampler::~Sampler() {
+    try {
+        stop();
+    } catch (...) {
+        // exceptions of the callback are ignored
+    }
+}
+
+void Sampler::start() {
+    if (thread.joinable()) throw std::logic_error("sampler is already running");
+
+    callback_exception = nullptr;
+    running            = true;
+
+    // the thread pins itself before the first cycle and reports the result
+    std::promise<int> pinned;
+    auto              pin_result = pinned.get_future();
+    thread                       = std::thread(&Sampler::run, this, std::move(pinned));
+
+    const auto result = pin_result.get();
+    if (result != 0) {
+        running = false;
+        thread.join();
+        throw std::system_error(result, std::generic_category(), "failed to pin sampler thread to cpu");
+    }
+}
+
+void Sampler::stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+
+    if (callback_exception) {
+        auto exception     = callback_exception;
+        callback_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+Sampler::Statistics Sampler::statistics() const {
+    Statistics result;
+    result.cycles           = cycles.load(std::memory_order_relaxed);
+    result.missed_deadlines = missed_deadlines.load(std::memory_order_relaxed);
+    result.latency_last     = latency_last.load(std::memory_order_relaxed);
+    result.latency_max      = latency_max.load(std::memory_order_relaxed);
+    result.duration_last    = duration_last.load(std::memory_order_relaxed);
+    result.duration_max     = duration_max.load(std::memory_order_relaxed);
+
+    if (result.cycles) {
+        const auto n         = static_cast<std::int64_t>(result.cycles);
+        result.latency_mean  = latency_sum.load(std::memory_order_relaxed) / n;
+        result.duration_mean = duration_sum.load(std::memory_order_relaxed) / n;
+    }
+
+    return result;
+}
+
+void Sampler::run(std::promise<int> pinned) {
+    const auto pin_result = pin_current_thread(cpu);
+    pinned.set_value(pin_result);
+    if (pin_result != 0) return;
+
+    const std::int64_t period_ns = period.count();
+    const auto         source    = const_cast<const void *>(region.address);
+
+    std::uint64_t sequence = 0;
+    std::int64_t  deadline = monotonic_now() + period_ns;
+
+    while (running.load(std::memory_order_relaxed)) {
+        const auto deadline_ts = to_timespec(deadline);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline_ts, nullptr) == EINTR) {}
+
+        const auto start = monotonic_now();
+        if (ring) {
+            ring->capture();
+        } else {
+            std::memcpy(snapshot.data(), source, snapshot.size());
+            const Frame frame {sequence++, std::chrono::system_clock::now(), snapshot.data(), snapshot.size()};
+
+            try {
+                callback(frame);
+            } catch (...) {
+                callback_exception = std::current_exception();
+                running            = false;
+            }
+        }
+
+        const auto end      = monotonic_now();
+        const auto latency  = start - deadline;
+        const auto duration = end - start;
+
+        latency_last.store(latency, std::memory_order_relaxed);
+        update_max(latency_max, latency);
+        latency_sum.fetch_add(latency, std::memory_order_relaxed);
+        duration_last.store(duration, std::memory_order_relaxed);
+        update_max(duration_max, duration);
+        duration_sum.fetch_add(duration, std::memory_order_relaxed);
+        cycles.fetch_add(1, std::memory_order_relaxed);
+
+        // skip deadlines that have already passed
+        deadline += period_ns;
+        if (end > deadline) {
+            const auto missed = (end - deadline) / period_ns + 1;
+            missed_deadlines.fetch_add(static_cast<std::uint64_t>(missed), std::memory_order_relaxed);
+            deadline += missed * period_ns;
+        }
+    }
+}
+
+}  // namespace memformat
+
+#endif
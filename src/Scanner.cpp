@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "Scanner.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+namespace memformat {
+
+/**
+ * @brief validate the scan arguments
+ * @param w word size
+ * @param e endianness
+ * @param options scan options
+ */
+static void check_arguments(wordsize w, endianness e, const ScanOptions &options) {
+    if (options.alignment == 0) throw std::invalid_argument("alignment must not be 0");
+
+    switch (w) {
+        case wordsize::BIT_1: throw std::invalid_argument("word size BIT_1 is not supported");
+        case wordsize::BIT_8:
+            if (e != endianness::HOST) throw std::invalid_argument("8 bit values only support endianness HOST");
+            break;
+        case wordsize::BIT_16:
+            if (e != endianness::HOST && e != endianness::BIG && e != endianness::LITTLE)
+                throw std::invalid_argument("endianness is not allowed for 16 bit values");
+            break;
+        case wordsize::BIT_32:
+            if (e == endianness::BIG_SWAP32 || e == endianness::LITTLE_SWAP32)
+                throw std::invalid_argument("endianness is not allowed for 32 bit values");
+            break;
+        case wordsize::BIT_64: break;
+    }
+}
+
+/**
+ * @brief add a match to the result
+ * @param offset offset of the match
+ * @param options scan options
+ * @param result result
+ * @return false if the maximum number of results is reached
+ */
+static bool add_match(std::size_t offset, const ScanOptions &options, std::vector<std::size_t> &result) {
+    if (offset % options.alignment) return true;
+    result.push_back(offset);
+    return result.size() < options.max_results;
+}
+
+/**
+ * @brief search a byte pattern
+ * @details SSE2: 16 candidate offsets are tested at once by comparing the first and the last byte of the pattern.
+ *          Only candidates that match both are compared completely.
+ *          The candidates before the first 16 byte boundary and behind the last complete block are tested scalar.
+ * @param data memory region
+ * @param size size of the memory region
+ * @param pattern pattern
+ * @param n size of the pattern (1..8)
+ * @param options scan options
+ * @return offsets of all matches
+ */
+static std::vector<std::size_t> find_pattern(const std::uint8_t *data,
+                                             std::size_t         size,
+                                             const std::uint8_t *pattern,
+                                             std::size_t         n,
+                                             const ScanOptions  &options) {
+    std::vector<std::size_t> result;
+    if (size < n || options.max_results == 0) return result;
+
+    const auto  last_offset = size - n;  // last offset that can contain the pattern
+    std::size_t offset      = 0;
+
+    // compare a single candidate offset (returns false if the scan is complete)
+    const auto check = [&](std::size_t candidate) {
+        return data[candidate] != pattern[0] || std::memcmp(data + candidate, pattern, n) != 0 ||
+               add_match(candidate, options, result);
+    };
+
+#if defined(__SSE2__)
+    const auto first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+    const auto last  = _mm_set1_epi8(static_cast<char>(pattern[n - 1]));
+
+    // scalar head up to the first 16 byte boundary: the first bytes of the candidates are loaded aligned
+    const auto head = std::min(last_offset + 1, (16 - (reinterpret_cast<std::uintptr_t>(data) & 0xF)) & 0xF);
+    for (; offset < head; ++offset)
+        if (!check(offset)) return result;
+
+    for (; offset + 16 <= last_offset + 1; offset += 16) {
+        const auto block_first = _mm_load_si128(reinterpret_cast<const __m128i *>(data + offset));
+        const auto block_last  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset + n - 1));
+        const auto eq          = _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last));
+
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        while (mask) {
+            const auto candidate = offset + static_cast<std::size_t>(__builtin_ctz(mask));
+            mask &= mask - 1;
+            if (std::memcmp(data + candidate, pattern, n) == 0 && !add_match(candidate, options, result))
+                return result;
+        }
+    }
+#endif
+
+    // scalar tail
+    for (; offset <= last_offset; ++offset)
+        if (!check(offset)) break;
+
+    return result;
+}
+
+/**
+ * @brief search the memory representation of a host value
+ * @tparam T unsigned integer type
+ * @param data memory region
+ * @param size size of the memory region
+ * @param e endianness
+ * @param value host value
+ * @param options scan options
+ * @return offsets of all matches
+ */
+template <typename T>
+static std::vector<std::size_t>
+        scan_value(const void *data, std::size_t size, endianness e, T value, const ScanOptions &options) {
+    T raw = value;
+    detail::with_endianness<T>(e, [&](auto E) { raw = detail::convert<T, decltype(E)::value>(value); });
+
+    std::uint8_t pattern[sizeof(T)];
+    std::memcpy(pattern, &raw, sizeof(T));
+    return find_pattern(static_cast<const std::uint8_t *>(data), size, pattern, sizeof(T), options);
+}
+
+std::vector<std::size_t> scan_unsigned(const void        *data,
+                                       std::size_t        size,
+                                       wordsize           w,
+                                       endianness         e,
+                                       std::uint64_t      value,
+                                       const ScanOptions &options) {
+    check_arguments(w, e, options);
+
+    switch (w) {
+        case wordsize::BIT_8:
+            if (value > UINT8_MAX) throw std::out_of_range("value does not fit into 8 bit");
+            return scan_value(data, size, e, static_cast<std::uint8_t>(value), options);
+        case wordsize::BIT_16:
+            if (value > UINT16_MAX) throw std::out_of_range("value does not fit into 16 bit");
+            return scan_value(data, size, e, static_cast<std::uint16_t>(value), options);
+        case wordsize::BIT_32:
+            if (value > UINT32_MAX) throw std::out_of_range("value does not fit into 32 bit");
+            return scan_value(data, size, e, static_cast<std::uint32_t>(value), options);
+        case wordsize::BIT_64: return scan_value(data, size, e, value, options);
+        case wordsize::BIT_1: break;
+    }
+    return {};
+}
+
+std::vector<std::size_t> scan_signed(const void        *data,
+                                     std::size_t        size,
+                                     wordsize           w,
+                                     endianness         e,
+                                     std::int64_t       value,
+                                     const ScanOptions &options) {
+    check_arguments(w, e, options);
+
+    switch (w) {
+        case wordsize::BIT_8:
+            if (value < INT8_MIN || value > INT8_MAX) throw std::out_of_range("value does not fit into 8 bit");
+            return scan_value(data, size, e, static_cast<std::uint8_t>(value), options);
+        case wordsize::BIT_16:
+            if (value < INT16_MIN || value > INT16_MAX) throw std::out_of_range("value does not fit into 16 bit");
+            return scan_value(data, size, e, static_cast<std::uint16_t>(value), options);
+        case wordsize::BIT_32:
+            if (value < INT32_MIN || value > INT32_MAX) throw std::out_of_range("value does not fit into 32 bit");
+            return scan_value(data, size, e, static_cast<std::uint32_t>(value), options);
+        case wordsize::BIT_64: return scan_value(data, size, e, static_cast<std::uint64_t>(value), options);
+        case wordsize::BIT_1: break;
+    }
+    return {};
+}
+
+std::vector<std::size_t> scan_float(const void        *data,
+                                    std::size_t        size,
+                                    wordsize           w,
+                                    endianness         e,
+                                    double             value,
+                                    const ScanOptions &options) {
+    check_arguments(w, e, options);
+
+    if (w == wordsize::BIT_32) {
+        const auto    f = static_cast<float>(value);
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return scan_value(data, size, e, bits, options);
+    }
+
+    if (w == wordsize::BIT_64) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return scan_value(data, size, e, bits, options);
+    }
+
+    throw std::invalid_argument("floating point values require word size BIT_32 or BIT_64");
+}
+
+/**
+ * @brief search values within a range
+ * @tparam T unsigned integer type
+ * @tparam E endianness
+ * @tparam Convert function type
+ * @param data memory region
+ * @param size size of the memory region
+ * @param convert function that converts a host value to double
+ * @param min smallest value
+ * @param max largest value
+ * @param options scan options
+ * @return offsets of all matches
+ */
+template <typename T, endianness E, typename Convert>
+static std::vector<std::size_t> find_range(const std::byte   *data,
+                                           std::size_t        size,
+                                           Convert            convert,
+                                           double             min,
+                                           double             max,
+                                           const ScanOptions &options) {
+    std::vector<std::size_t> result;
+    if (size < sizeof(T) || options.max_results == 0) return result;
+
+    for (std::size_t offset = 0; offset <= size - sizeof(T); offset += options.alignment) {
+        const double x = convert(detail::decode<T, E>(data + offset));
+        if (x >= min && x <= max && !add_match(offset, options, result)) break;
+    }
+    return result;
+}
+
+/**
+ * @brief search values within a range (dispatches endianness and format)
+ * @tparam T unsigned integer type
+ */
+template <typename T>
+static std::vector<std::size_t> scan_range_wordsize(const std::byte   *data,
+                                                    std::size_t        size,
+                                                    endianness         e,
+                                                    format             f,
+                                                    double             min,
+                                                    double             max,
+                                                    const ScanOptions &options) {
+    std::vector<std::size_t> result;
+    detail::with_endianness<T>(e, [&](auto E) {
+        constexpr auto endian = decltype(E)::value;
+        if (f == format::UNSIGNED) {
+            const auto convert = [](T v) { return static_cast<double>(v); };
+            result             = find_range<T, endian>(data, size, convert, min, max, options);
+        } else if (f == format::SIGNED) {
+            const auto convert = [](T v) { return static_cast<double>(static_cast<std::make_signed_t<T>>(v)); };
+            result             = find_range<T, endian>(data, size, convert, min, max, options);
+        } else if constexpr (sizeof(T) >= 4) {
+            using float_t      = std::conditional_t<sizeof(T) == 4, float, double>;
+            const auto convert = [](T v) {
+                float_t x;
+                std::memcpy(&x, &v, sizeof(x));
+                return static_cast<double>(x);
+            };
+            result = find_range<T, endian>(data, size, convert, min, max, options);
+        }
+    });
+    return result;
+}
+
+std::vector<std::size_t> scan_range(const void        *data,
+                                    std::size_t        size,
+                                    wordsize           w,
+                                    endianness         e,
+                                    format             f,
+                                    double             min,
+                                    double             max,
+                                    const ScanOptions &options) {
+    check_arguments(w, e, options);
+    if (!(min <= max)) throw std::invalid_argument("invalid value range");
+    if (f != format::SIGNED && f != format::UNSIGNED && f != format::FLOAT)
+        throw std::invalid_argument("only the formats SIGNED, UNSIGNED and FLOAT are supported");
+    if (f == format::FLOAT && w != wordsize::BIT_32 && w != wordsize::BIT_64)
+        throw std::invalid_argument("floating point values require word size BIT_32 or BIT_64");
+
+    const auto *bytes = static_cast<const std::byte *>(data);
+    switch (w) {
+        case wordsize::BIT_8: return scan_range_wordsize<std::uint8_t>(bytes, size, e, f, min, max, options);
+        case wordsize::BIT_16: return scan_range_wordsize<std::uint16_t>(bytes, size, e, f, min, max, options);
+        case wordsize::BIT_32: return scan_range_wordsize<std::uint32_t>(bytes, size, e, f, min, max, options);
+        case wordsize::BIT_64: return scan_range_wordsize<std::uint64_t>(bytes, size, e, f, min, max, options);
+        case wordsize::BIT_1: break;
+    }
+    return {};
+}
+
+}  // namespace memformat
@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#ifdef OS_POSIX
+
+#    include "StreamWriter.hpp"
+
+#    include <algorithm>
+#    include <cerrno>
+#    include <cstdlib>
+#    include <cstring>
+#    include <new>
+#    include <stdexcept>
+#    include <system_error>
+#    include <unistd.h>
+
+#    ifdef MEMFORMAT_IO_URING
+#        include <liburing.h>
+#    endif
+
+namespace memformat {
+
+//* maximum number of io vectors per system call (IOV_MAX on Linux)
+static constexpr std::size_t MAX_IOV = 1024;
+
+//* number of submission queue entries (only a single write is in flight at any time)
+[[maybe_unused]] static constexpr unsigned IO_URING_ENTRIES = 4;
+
+#    ifdef MEMFORMAT_IO_URING
+struct StreamWriter::IoUring {
+    struct io_uring ring {};
+    bool            initialized = false;
+
+    IoUring() { initialized = io_uring_queue_init(IO_URING_ENTRIES, &ring, 0) == 0; }
+
+    IoUring(const IoUring &)            = delete;
+    IoUring(IoUring &&)                 = delete;
+    IoUring &operator=(const IoUring &) = delete;
+    IoUring &operator=(IoUring &&)      = delete;
+
+    ~IoUring() {
+        if (initialized) io_uring_queue_exit(&ring);
+    }
+};
+#    else
+struct StreamWriter::IoUring {};
+#    endif
+
+/**
+ * @brief get system page size
+ * @return page size in bytes
+ */
+static std::size_t page_size() {
+    const auto size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<std::size_t>(size) : 4096;
+}
+
+/**
+ * @brief round buffer size up to a multiple of the page size
+ * @param size requested buffer size
+ * @return buffer size
+ */
+static std::size_t round_to_pages(std::size_t size) {
+    const auto page = page_size();
+    size            = std::max(size, MAX_STRING_LENGTH);
+    return ((size + page - 1) / page) * page;
+}
+
+/**
+ * @brief check whether an error number indicates that the operation would block
+ * @param error error number
+ * @return true if the operation would block
+ */
+static bool would_block(int error) {
+#    if EWOULDBLOCK != EAGAIN
+    if (error == EWOULDBLOCK) return true;
+#    endif
+    return error == EAGAIN;
+}
+
+StreamWriter::StreamWriter(int fd, std::size_t buffer_size, std::size_t max_buffers)
+    : fd(fd), buffer_size(round_to_pages(buffer_size)), max_buffers(max_buffers) {
+    if (max_buffers == 0) throw std::invalid_argument("max_buffers must not be 0");
+
+#    ifdef MEMFORMAT_IO_URING
+    auto ring = std::make_unique<IoUring>();
+    if (ring->initialized) uring = std::move(ring);
+#    endif
+}
+
+StreamWriter::~StreamWriter() {
+    try {
+        if (uring) {
+            // the memory can not be released while the kernel still accesses it
+            io_uring_complete(true);
+
+            // write the remaining data as long as there is progress
+            while (pending_bytes()) {
+                io_uring_submit_pending();
+                if (!in_flight || io_uring_complete(true) == 0) break;
+            }
+        } else {
+            flush_writev();
+        }
+    } catch (const std::exception &) {
+        // errors are ignored
+    }
+
+    for (auto &buffer : buffers)
+        std::free(buffer.data);
+    for (auto *buffer : free_buffers)
+        std::free(buffer);
+}
+
+bool StreamWriter::write(std::string_view data) {
+    if (data.size() > free_space()) return false;
+
+    while (!data.empty()) {
+        if (buffers.empty() || buffers.back().used == buffer_size) push_buffer();
+
+        auto      &buffer = buffers.back();
+        const auto n      = std::min(data.size(), buffer_size - buffer.used);
+        std::memcpy(buffer.data + buffer.used, data.data(), n);
+        buffer.used += n;
+        data.remove_prefix(n);
+    }
+
+    return true;
+}
+
+bool StreamWriter::write(const MemoryFormatter &formatter) {
+    if (!reserve_contiguous(MAX_STRING_LENGTH)) return false;
+
+    auto &buffer = buffers.back();
+    buffer.used  = static_cast<std::size_t>(formatter.format_to(buffer.data + buffer.used) - buffer.data);
+    return true;
+}
+
+std::size_t StreamWriter::flush() {
+    if (!uring) return flush_writev();
+
+    const auto done = io_uring_complete(false);
+    if (!in_flight) io_uring_submit_pending();
+    return done;
+}
+
+std::size_t StreamWriter::pending_bytes() const {
+    std::size_t pending = 0;
+    for (const auto &buffer : buffers)
+        pending += buffer.used - buffer.written;
+    return pending;
+}
+
+std::size_t StreamWriter::free_space() const {
+    std::size_t space = buffers.empty() ? 0 : buffer_size - buffers.back().used;
+    space += (free_buffers.size() + max_buffers - allocated) * buffer_size;
+    return space;
+}
+
+bool StreamWriter::reserve_contiguous(std::size_t n) {
+    if (!buffers.empty() && buffer_size - buffers.back().used >= n) return true;
+    return push_buffer();
+}
+
+bool StreamWriter::push_buffer() {
+    char *data;
+    if (!free_buffers.empty()) {
+        data = free_buffers.back();
+        free_buffers.pop_back();
+    } else if (allocated < max_buffers) {
+        data = static_cast<char *>(std::aligned_alloc(page_size(), buffer_size));
+        if (!data) throw std::bad_alloc();
+        ++allocated;
+    } else {
+        return false;
+    }
+
+    buffers.push_back({data});
+    return true;
+}
+
+void StreamWriter::consume(std::size_t n) {
+    total_written += n;
+
+    while (!buffers.empty()) {
+        auto      &buffer = buffers.front();
+        const auto chunk  = std::min(n, buffer.used - buffer.written);
+        buffer.written += chunk;
+        n -= chunk;
+
+        if (buffer.written != buffer.used) break;
+
+        if (buffers.size() == 1) {
+            // keep the last buffer to append further data
+            buffer.used    = 0;
+            buffer.written = 0;
+            break;
+        }
+
+        free_buffers.push_back(buffer.data);
+        buffers.pop_front();
+    }
+}
+
+void StreamWriter::collect_iov() {
+    iov.clear();
+    for (auto &buffer : buffers) {
+        if (iov.size() == MAX_IOV) break;
+        if (buffer.used == buffer.written) continue;
+        iov.push_back({buffer.data + buffer.written, buffer.used - buffer.written});
+    }
+}
+
+std::size_t StreamWriter::flush_writev() {
+    collect_iov();
+    if (iov.empty()) return 0;
+
+    ssize_t result;
+    do {
+        result = ::writev(fd, iov.data(), static_cast<int>(iov.size()));
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        if (would_block(errno)) return 0;
+        throw std::system_error(errno, std::generic_category(), "writev");
+    }
+
+    consume(static_cast<std::size_t>(result));
+    return static_cast<std::size_t>(result);
+}
+
+#    ifdef MEMFORMAT_IO_URING
+std::size_t StreamWriter::io_uring_complete(bool wait) {
+    if (!in_flight) return 0;
+
+    struct io_uring_cqe *cqe = nullptr;
+
+    int result;
+    do {
+        result = wait ? io_uring_wait_cqe(&uring->ring, &cqe) : io_uring_peek_cqe(&uring->ring, &cqe);
+    } while (result == -EINTR);
+
+    if (result == -EAGAIN) return 0;  // not yet completed
+    if (result < 0) throw std::system_error(-result, std::generic_category(), "io_uring_wait_cqe");
+
+    const auto res = cqe->res;
+    io_uring_cqe_seen(&uring->ring, cqe);
+    in_flight = false;
+
+    if (res < 0) {
+        if (res == -EINTR || would_block(-res)) return 0;
+        throw std::system_error(-res, std::generic_category(), "io_uring writev");
+    }
+
+    consume(static_cast<std::size_t>(res));
+    return static_cast<std::size_t>(res);
+}
+
+void StreamWriter::io_uring_submit_pending() {
+    collect_iov();
+    if (iov.empty()) return;
+
+    auto *sqe = io_uring_get_sqe(&uring->ring);
+    if (!sqe) return;
+
+    // the submitted data is not modified until the operation is completed:
+    // consume() is only called on completion and write() only appends behind the submitted data
+    io_uring_prep_writev(sqe, fd, iov.data(), static_cast<unsigned>(iov.size()), ~static_cast<__u64>(0));
+    const auto result = io_uring_submit(&uring->ring);
+    if (result < 0) throw std::system_error(-result, std::generic_category(), "io_uring_submit");
+    in_flight = true;
+}
+#    else
+std::size_t StreamWriter::io_uring_complete(bool) { return 0; }
+
+void StreamWriter::io_uring_submit_pending() {}
+#    endif
+
+}  // namespace memformat
+
+#endif
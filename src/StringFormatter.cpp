@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "StringFormatter.hpp"
+
+#include "MemoryFormatterDetail.hpp"
+#include "MemoryFormatterImpl.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define MEMFORMAT_STRING_SSSE3
+#    include <tmmintrin.h>
+#endif
+
+namespace memformat {
+
+//* size of a shuffle block (multiple of all word sizes)
+static constexpr std::size_t BLOCK_SIZE = 16;
+
+#ifdef MEMFORMAT_STRING_SSSE3
+/**
+ * @brief check whether the CPU supports SSSE3
+ * @details The result is determined once. Builds with -mssse3 (or a newer instruction set) skip the check.
+ * @return true if shuffle_blocks can be used
+ */
+static bool has_ssse3() {
+#    if defined(__SSSE3__)
+    return true;
+#    else
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") != 0;
+    }();
+    return supported;
+#    endif
+}
+
+/**
+ * @brief reorder the bytes of all blocks of a field with SSSE3 byte shuffles
+ * @details Compiled for SSSE3 independent of the target options of the build: only call if has_ssse3() is true.
+ * @param src field (16 byte aligned, readable up to the next multiple of BLOCK_SIZE)
+ * @param dst output (16 byte aligned, writable up to the next multiple of BLOCK_SIZE)
+ * @param length field length in bytes
+ * @param shuffle source index of every byte of a block
+ */
+__attribute__((target("ssse3"))) static void
+        shuffle_blocks(const std::uint8_t *src, std::uint8_t *dst, std::size_t length, const std::uint8_t *shuffle) {
+    const auto mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle));
+    for (std::size_t i = 0; i < length; i += BLOCK_SIZE) {
+        const auto block = _mm_load_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_store_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(block, mask));
+    }
+}
+#endif
+
+/**
+ * @brief formatter that writes a fixed length character field as string
+ */
+class MemoryFormatter_String final : public MemoryFormatter {
+private:
+    const std::size_t                    length;       //*< field length in bytes
+    const string_termination             termination;  //*< end of the string in the field
+    const bool                           escape;       //*< escape non-printable characters
+    std::array<std::uint8_t, BLOCK_SIZE> shuffle {};   //*< source index of every byte of a block
+
+public:
+    MemoryFormatter_String(void              *base_address,
+                           std::size_t        offset,
+                           std::size_t        length,
+                           wordsize           w,
+                           endianness         e,
+                           string_termination termination,
+                           bool               escape)
+        : MemoryFormatter(base_address, offset, w, format::STRING, e),
+          length(length),
+          termination(termination),
+          escape(escape) {
+        if (w == wordsize::BIT_1) throw std::invalid_argument("word size BIT_1 is not supported by string formatters");
+        const auto bytes = detail::word_bytes(w);
+        if (length == 0) throw std::invalid_argument("string length is 0");
+        if (length % bytes != 0) throw std::invalid_argument("string length is not a multiple of the word size");
+        if (length * (escape ? 4 : 1) > MAX_STRING_LENGTH)
+            throw std::invalid_argument("the longest output exceeds MAX_STRING_LENGTH");
+
+        // the byte order of a word is taken from the numeric formatter (the word of a field with the bytes 0, 1, ...
+        // is converted to host endianness; its most significant byte is the index of the first character)
+        std::uint8_t indices[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        const auto   raw        = detail::new_formatter(indices, 0, w, format::HEX, e, 0)->raw();
+
+        for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+            const auto byte = (bytes - 1 - i % bytes) * 8;
+            shuffle[i]      = static_cast<std::uint8_t>(i - i % bytes + ((raw >> byte) & 0xFF));
+        }
+    }
+
+    [[nodiscard]] std::string string() const override { return format_string(); }
+
+    [[nodiscard]] std::size_t max_offset() const override { return offset + length - 1; }
+
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> relocate(void *base, std::size_t offset) const override {
+        return std::make_shared<MemoryFormatter_String>(base, offset, length, word_size, endian, termination, escape);
+    }
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override;
+
+private:
+    /**
+     * @brief reorder the bytes of the field
+     * @param src field (length bytes, readable up to the next multiple of BLOCK_SIZE)
+     * @param dst output (length bytes, writable up to the next multiple of BLOCK_SIZE)
+     */
+    void reorder(const std::uint8_t *src, std::uint8_t *dst) const;
+};
+
+void MemoryFormatter_String::reorder(const std::uint8_t *src, std::uint8_t *dst) const {
+#ifdef MEMFORMAT_STRING_SSSE3
+    if (has_ssse3()) {
+        shuffle_blocks(src, dst, length, shuffle.data());
+        return;
+    }
+#endif
+
+    // scalar fallback (the length is a multiple of the word size: every block index stays inside the field)
+    for (std::size_t i = 0; i < length; ++i)
+        dst[i] = src[i - i % BLOCK_SIZE + shuffle[i % BLOCK_SIZE]];
+}
+
+char *MemoryFormatter_String::format_value(volatile void *base, char *dest, memory_access access) const {
+    static constexpr std::size_t BUFFER_SIZE = (MAX_STRING_LENGTH + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+    alignas(BLOCK_SIZE) std::uint8_t field[BUFFER_SIZE];
+    alignas(BLOCK_SIZE) std::uint8_t chars[BUFFER_SIZE];
+
+    // the characters are not read as a single value: every byte is read with the requested access semantics
+    if (access == memory_access::PLAIN) {
+        const auto *src = const_cast<const std::uint8_t *>(static_cast<volatile std::uint8_t *>(base));
+        std::memcpy(field, src + offset, length);
+    } else {
+        for (std::size_t i = 0; i < length; ++i)
+            field[i] = detail::load<std::uint8_t>(base, offset + i, true, access);
+    }
+
+    reorder(field, chars);
+
+    std::size_t size = length;
+    switch (termination) {
+        case string_termination::NUL: {
+            const auto *nul = static_cast<const std::uint8_t *>(std::memchr(chars, 0, length));
+            if (nul) size = static_cast<std::size_t>(nul - chars);
+            break;
+        }
+        case string_termination::TRIM:
+            while (size > 0 && (chars[size - 1] == 0 || chars[size - 1] == ' '))
+                --size;
+            break;
+        case string_termination::NONE: break;
+    }
+
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto c = chars[i];
+        if (c >= 0x20 && c < 0x7F && (c != '\\' || !escape)) {
+            *dest++ = static_cast<char>(c);
+        } else if (!escape) {
+            *dest++ = '.';
+        } else if (c == '\\') {
+            *dest++ = '\\';
+            *dest++ = '\\';
+        } else {
+            *dest++ = '\\';
+            *dest++ = 'x';
+            *dest++ = HEX_DIGITS[c >> 4];
+            *dest++ = HEX_DIGITS[c & 0xF];
+        }
+    }
+
+    return dest;
+}
+
+std::shared_ptr<MemoryFormatter> get_string_formatter(void              *base_addr,
+                                                      std::size_t        offset,
+                                                      std::size_t        length,
+                                                      wordsize           w,
+                                                      endianness         e,
+                                                      string_termination termination,
+                                                      bool               escape) {
+    return std::make_shared<MemoryFormatter_String>(base_addr, offset, length, w, e, termination, escape);
+}
+
+}  // namespace memformat
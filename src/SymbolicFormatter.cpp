@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "SymbolicFormatter.hpp"
+
+#include "MemoryFormatterImpl.hpp"
+#include "MemoryFormatterDetail.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace memformat {
+
+//* labels are stored in a dense array if the value range is smaller than DENSE_FACTOR * labels + DENSE_MIN
+static constexpr std::uint64_t DENSE_FACTOR = 4;
+static constexpr std::uint64_t DENSE_MIN    = 64;
+
+LabelTable::LabelTable(const Entries &entries) : count(entries.size()) {
+    std::uint64_t max_value = 0;
+    min_value               = std::numeric_limits<std::uint64_t>::max();
+    for (const auto &[value, label] : entries) {
+        if (label.empty()) throw std::invalid_argument("empty label");
+        if (label.size() > MAX_STRING_LENGTH) throw std::invalid_argument("label is longer than MAX_STRING_LENGTH");
+
+        min_value  = std::min(min_value, value);
+        max_value  = std::max(max_value, value);
+        max_length = std::max(max_length, label.size());
+    }
+    if (entries.empty()) min_value = 0;
+
+    dense = max_value - min_value < DENSE_FACTOR * count + DENSE_MIN;
+
+    if (dense) {
+        slots.resize(entries.empty() ? 0 : max_value - min_value + 1);
+    } else {
+        // power of 2 with at least 2 slots per label
+        unsigned bits = 1;
+        while ((std::size_t {1} << bits) < 2 * count)
+            ++bits;
+        slots.resize(std::size_t {1} << bits);
+        hash_shift = 64 - bits;
+    }
+
+    for (const auto &[value, label] : entries) {
+        if (text.size() + label.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("label table is too large");
+
+        Slot *slot;
+        if (dense) {
+            slot = &slots[value - min_value];
+        } else {
+            const auto mask  = slots.size() - 1;
+            auto       index = hash(value);
+            while (slots[index].size != 0 && slots[index].value != value)
+                index = (index + 1) & mask;
+            slot = &slots[index];
+        }
+
+        if (slot->size != 0) {
+            std::ostringstream error_msg;
+            error_msg << "duplicate label value " << value;
+            throw std::invalid_argument(error_msg.str());
+        }
+
+        slot->value  = value;
+        slot->offset = static_cast<std::uint32_t>(text.size());
+        slot->size   = static_cast<std::uint32_t>(label.size());
+        text += label;
+    }
+}
+
+/**
+ * @brief get the index of the lowest set bit
+ * @param value value (must not be 0)
+ * @return bit index
+ */
+static std::size_t lowest_bit(std::uint64_t value) {
+#ifdef __GNUC__
+    return static_cast<std::size_t>(__builtin_ctzll(value));
+#else
+    std::size_t bit = 0;
+    while (!(value & 0x1)) {
+        value >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief formatter that writes the label of the memory value
+ * @tparam Reader abstract formatter of the word size (reads the value)
+ */
+template <typename Reader>
+class MemoryFormatter_Enum final : public Reader {
+private:
+    std::shared_ptr<const LabelTable> labels;  //*< label table
+
+public:
+    MemoryFormatter_Enum(void                             *base_address,
+                         std::size_t                       offset,
+                         endianness                        endian,
+                         std::shared_ptr<const LabelTable> labels)
+        : Reader(base_address, offset, endian, format::LABEL), labels(std::move(labels)) {}
+
+    [[nodiscard]] std::string string() const override { return this->format_string(); }
+
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> relocate(void *base, std::size_t offset) const override {
+        return std::make_shared<MemoryFormatter_Enum>(base, offset, this->endian, labels);
+    }
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override {
+        const auto value = static_cast<std::uint64_t>(this->get_data(base, access));
+        const auto label = labels->find(value);
+        if (label.empty()) return detail::int_to_chars(dest, value);
+        return std::copy(label.begin(), label.end(), dest);
+    }
+};
+
+/**
+ * @brief bit labels of a bitmask formatter
+ */
+struct BitLabels {
+    std::array<std::string_view, 64>  labels;     //*< label of each bit (empty: no label)
+    std::uint64_t                     known = 0;  //*< bits with label
+    std::string                       separator;  //*< separator between two labels
+    std::shared_ptr<const LabelTable> table;      //*< label table (owns the label text)
+};
+
+/**
+ * @brief formatter that writes the labels of the bits that are set in the memory value
+ * @tparam Reader abstract formatter of the word size (reads the value)
+ */
+template <typename Reader>
+class MemoryFormatter_Bitmask final : public Reader {
+private:
+    std::shared_ptr<const BitLabels> bits;  //*< bit labels
+
+public:
+    MemoryFormatter_Bitmask(void                            *base_address,
+                            std::size_t                      offset,
+                            endianness                       endian,
+                            std::shared_ptr<const BitLabels> bits)
+        : Reader(base_address, offset, endian, format::LABEL), bits(std::move(bits)) {}
+
+    [[nodiscard]] std::string string() const override { return this->format_string(); }
+
+    [[nodiscard]] std::shared_ptr<MemoryFormatter> relocate(void *base, std::size_t offset) const override {
+        return std::make_shared<MemoryFormatter_Bitmask>(base, offset, this->endian, bits);
+    }
+
+protected:
+    char *format_value(volatile void *base, char *dest, memory_access access) const override {
+        const auto value = static_cast<std::uint64_t>(this->get_data(base, access));
+        if (value == 0) {
+            *dest = '0';
+            return dest + 1;
+        }
+
+        char *const start = dest;
+        auto        set   = value & bits->known;
+        while (set) {
+            if (dest != start) dest = std::copy(bits->separator.begin(), bits->separator.end(), dest);
+
+            const auto &label = bits->labels[lowest_bit(set)];
+            dest              = std::copy(label.begin(), label.end(), dest);
+            set &= set - 1;
+        }
+
+        const auto unknown = value & ~bits->known;
+        if (unknown) {
+            if (dest != start) dest = std::copy(bits->separator.begin(), bits->separator.end(), dest);
+            *dest++ = '0';
+            *dest++ = 'x';
+            dest    = detail::int_to_chars(dest, unknown, 16);
+        }
+
+        return dest;
+    }
+};
+
+/**
+ * @brief create a formatter for a word size
+ * @tparam Formatter formatter template (MemoryFormatter_Enum or MemoryFormatter_Bitmask)
+ * @tparam Data type of the shared formatter data
+ * @param base_addr memory base address
+ * @param offset memory offset
+ * @param w word size
+ * @param e endianness
+ * @param data shared formatter data
+ * @return formatter
+ *
+ * @exception std::invalid_argument word size BIT_1 or invalid endianness for the word size
+ */
+template <template <typename> class Formatter, typename Data>
+static std::shared_ptr<MemoryFormatter> create(void                       *base_addr,
+                                               std::size_t                 offset,
+                                               wordsize                    w,
+                                               endianness                  e,
+                                               std::shared_ptr<const Data> data) {
+    switch (w) {
+        case wordsize::BIT_8:
+            return std::make_shared<Formatter<MemoryFormatter_Bit_8>>(base_addr, offset, e, std::move(data));
+        case wordsize::BIT_16:
+            return std::make_shared<Formatter<MemoryFormatter_Bit_16>>(base_addr, offset, e, std::move(data));
+        case wordsize::BIT_32:
+            return std::make_shared<Formatter<MemoryFormatter_Bit_32>>(base_addr, offset, e, std::move(data));
+        case wordsize::BIT_64:
+            return std::make_shared<Formatter<MemoryFormatter_Bit_64>>(base_addr, offset, e, std::move(data));
+        case wordsize::BIT_1: break;
+    }
+    throw std::invalid_argument("word size BIT_1 is not supported by symbolic formatters");
+}
+
+std::shared_ptr<MemoryFormatter> get_enum_formatter(void                             *base_addr,
+                                                    std::size_t                       offset,
+                                                    wordsize                          w,
+                                                    endianness                        e,
+                                                    std::shared_ptr<const LabelTable> labels) {
+    if (!labels) throw std::invalid_argument("labels is a nullptr");
+    return create<MemoryFormatter_Enum>(base_addr, offset, w, e, std::move(labels));
+}
+
+std::shared_ptr<MemoryFormatter> get_bitmask_formatter(void                             *base_addr,
+                                                       std::size_t                       offset,
+                                                       wordsize                          w,
+                                                       endianness                        e,
+                                                       std::shared_ptr<const LabelTable> labels,
+                                                       std::string_view                  separator) {
+    if (!labels) throw std::invalid_argument("labels is a nullptr");
+
+    std::size_t word_bits = 64;
+    switch (w) {
+        case wordsize::BIT_1:
+        case wordsize::BIT_8: word_bits = 8; break;
+        case wordsize::BIT_16: word_bits = 16; break;
+        case wordsize::BIT_32: word_bits = 32; break;
+        case wordsize::BIT_64: word_bits = 64; break;
+    }
+
+    auto bits       = std::make_shared<BitLabels>();
+    bits->separator = separator;
+    bits->table     = labels;
+
+    // longest output: all labels and the unknown bits (0x + 16 digits), separated by separator
+    std::size_t max_output = 18;
+    bool        error      = false;
+    labels->for_each([&](std::uint64_t value, std::string_view label) {
+        if (value == 0 || (value & (value - 1)) != 0 || lowest_bit(value) >= word_bits) {
+            error = true;
+            return;
+        }
+
+        bits->labels[lowest_bit(value)] = label;
+        bits->known |= value;
+        max_output += label.size() + separator.size();
+    });
+
+    if (error) throw std::invalid_argument("every label value must be a single bit of the word size");
+    if (max_output > MAX_STRING_LENGTH) throw std::invalid_argument("the longest output exceeds MAX_STRING_LENGTH");
+
+    return create<MemoryFormatter_Bitmask>(base_addr, offset, w, e, std::shared_ptr<const BitLabels>(std::move(bits)));
+}
+
+}  // namespace memformat
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * recording file format (host byte order)
+ *
+ *   FileHeader
+ *   RecordHeader, payload
+ *   RecordHeader, payload
+ *   ...
+ *
+ * The payload of a keyframe is a raw copy of the memory region.
+ * The payload of a delta frame is the XOR of the frame and the previous frame, encoded as a sequence of
+ *   varint(number of unchanged bytes), varint(number of changed bytes), changed bytes (XOR)
+ * An identical frame has an empty payload.
+ */
+
+namespace memformat::detail {
+
+constexpr char          RECORDING_MAGIC[8]   = {'M', 'E', 'M', 'F', 'R', 'E', 'C', '\0'};
+constexpr std::uint32_t RECORDING_VERSION    = 1;
+constexpr std::uint32_t RECORDING_BYTE_ORDER = 0x01020304;
+constexpr std::uint32_t RECORD_KEYFRAME      = 0x1;
+
+//* minimum number of unchanged bytes that terminate a sequence of changed bytes
+constexpr std::size_t MIN_UNCHANGED_RUN = 8;
+
+struct RecordingHeader {
+    char          magic[8];            //*< RECORDING_MAGIC
+    std::uint32_t version;             //*< RECORDING_VERSION
+    std::uint32_t byte_order;          //*< RECORDING_BYTE_ORDER (detects files of hosts with another byte order)
+    std::uint64_t region_size;         //*< size of the recorded memory region
+    std::uint32_t keyframe_interval;   //*< maximum distance between two keyframes
+    std::uint32_t record_header_size;  //*< sizeof(RecordHeader)
+};
+
+struct RecordHeader {
+    std::uint32_t size;       //*< size of the record (header and payload)
+    std::uint32_t flags;      //*< RECORD_KEYFRAME
+    std::int64_t  timestamp;  //*< nanoseconds since the epoch of the system clock
+    std::uint64_t sequence;   //*< frame number
+};
+
+static_assert(sizeof(RecordingHeader) == 32);
+static_assert(sizeof(RecordHeader) == 24);
+
+/**
+ * @brief append unsigned LEB128 value
+ * @param out output buffer
+ * @param value value
+ */
+static inline void put_varint(std::vector<std::byte> &out, std::size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::byte>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::byte>(value));
+}
+
+/**
+ * @brief read unsigned LEB128 value
+ * @param p read position (advanced behind the value)
+ * @param end end of the input
+ * @param value output value
+ * @return false if the input is truncated or the value is too large
+ */
+static inline bool get_varint(const std::byte *&p, const std::byte *end, std::size_t &value) {
+    value = 0;
+    for (unsigned shift = 0; p != end && shift < sizeof(value) * 8; shift += 7) {
+        const auto byte = std::to_integer<std::size_t>(*p++);
+        value |= (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief append XOR delta of two frames
+ * @param prev previous frame
+ * @param cur current frame
+ * @param size frame size
+ * @param out output buffer
+ */
+static inline void encode_delta(const std::byte        *prev,
+                                const std::byte        *cur,
+                                std::size_t             size,
+                                std::vector<std::byte> &out) {
+    std::size_t pos = 0;
+    while (pos < size) {
+        const auto start = pos;
+        while (pos < size && prev[pos] == cur[pos])
+            ++pos;
+        if (pos == size) break;
+
+        // changed bytes end before MIN_UNCHANGED_RUN unchanged bytes (or at the end of the frame)
+        const auto  first_changed = pos;
+        auto        end           = pos;
+        std::size_t unchanged     = 0;
+        for (; pos < size && unchanged < MIN_UNCHANGED_RUN; ++pos) {
+            if (prev[pos] == cur[pos]) {
+                ++unchanged;
+            } else {
+                unchanged = 0;
+                end       = pos + 1;
+            }
+        }
+        pos = end;
+
+        put_varint(out, first_changed - start);
+        put_varint(out, end - first_changed);
+        for (auto i = first_changed; i < end; ++i)
+            out.push_back(prev[i] ^ cur[i]);
+    }
+}
+
+/**
+ * @brief apply XOR delta to the previous frame
+ * @param p delta
+ * @param end end of the delta
+ * @param frame previous frame (modified to the current frame)
+ * @param size frame size
+ * @return false if the delta is invalid
+ */
+static inline bool apply_delta(const std::byte *p, const std::byte *end, std::byte *frame, std::size_t size) {
+    std::size_t pos = 0;
+    while (p != end) {
+        std::size_t skip;
+        std::size_t count;
+        if (!get_varint(p, end, skip) || !get_varint(p, end, count)) return false;
+        if (skip > size - pos || count > size - pos - skip) return false;
+        if (count > static_cast<std::size_t>(end - p)) return false;
+
+        pos += skip;
+        for (std::size_t i = 0; i < count; ++i)
+            frame[pos++] ^= *p++;
+    }
+    return true;
+}
+
+}  // namespace memformat::detail
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "MemoryFormatter.hpp"
+#include "Scanner.hpp"
+#include "StaticLayout.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief check formatters of a word size at every alignment
+ * @tparam T unsigned integer type
+ * @param w word size
+ * @param data memory (at least 16 + sizeof(T) bytes, 8 byte aligned)
+ */
+template <typename T>
+static void check_word(memformat::wordsize w, uint8_t *data) {
+    using memformat::endianness;
+    using memformat::format;
+
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        T expected;
+        std::memcpy(&expected, data + offset, sizeof(T));
+
+        // aligned or unaligned depending on the offset
+        const auto formatter = memformat::MemoryFormatter::get_formatter(data, offset, w, format::UNSIGNED);
+        assert(formatter->string() == std::to_string(expected));
+        assert(formatter->raw() == expected);
+
+        // relocated base address with a different alignment
+        const auto relocated = memformat::MemoryFormatter::get_formatter(data + 8, offset, w, format::UNSIGNED);
+        assert(relocated->result(data + 1) == formatter->result(data + 1));
+
+        // unaligned base address
+        const auto unaligned = memformat::MemoryFormatter::get_formatter(data + 1, offset, w, format::UNSIGNED);
+        T          expected_unaligned;
+        std::memcpy(&expected_unaligned, data + 1 + offset, sizeof(T));
+        assert(unaligned->string() == std::to_string(expected_unaligned));
+    }
+}
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    alignas(16) uint8_t data[64];
+    for (std::size_t i = 0; i < sizeof(data); ++i)
+        data[i] = static_cast<uint8_t>(0x9D * i + 0x31);
+
+    check_word<uint16_t>(wordsize::BIT_16, data);
+    check_word<uint32_t>(wordsize::BIT_32, data);
+    check_word<uint64_t>(wordsize::BIT_64, data);
+
+    // compile time layouts at unaligned offsets
+    using Field = memformat::StaticField<3, wordsize::BIT_32, format::HEX, endianness::BIG>;
+    const auto formatter =
+            memformat::MemoryFormatter::get_formatter(data, 3, wordsize::BIT_32, format::HEX, endianness::BIG);
+    char       buffer[memformat::MAX_STRING_LENGTH];
+    assert(std::string(buffer, Field::format_to(data, buffer)) == formatter->string());
+
+    // scan with every alignment of the scanned region (scalar head, aligned body, scalar tail)
+    const uint32_t value = 0xDEADBEEF;
+    for (std::size_t start = 0; start < 16; ++start) {
+        alignas(16) uint8_t region[80] {};
+        for (const std::size_t position : {start, start + 5, start + 23, std::size_t {70}})
+            std::memcpy(region + position, &value, sizeof(value));
+
+        const auto found = memformat::scan_unsigned(
+                region + start, sizeof(region) - start, wordsize::BIT_32, endianness::HOST, value);
+        assert(found.size() == 4);
+        assert(found[0] == 0 && found[1] == 5 && found[2] == 23 && found[3] == 70 - start);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "BatchDecoder.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    // typed value accessor
+    {
+        alignas(8) uint8_t data[16];
+        const double       d = -2.5;
+        const float        f = 0.75F;
+        std::memcpy(data, &d, sizeof(d));
+        std::memcpy(data + 8, &f, sizeof(f));
+        data[12] = 0xFE;
+        data[13] = 0x12;
+        data[14] = 0x34;
+
+        using memformat::MemoryFormatter;
+        const auto f64 = MemoryFormatter::get_formatter(data, 0, wordsize::BIT_64, format::FLOAT);
+        const auto f32 = MemoryFormatter::get_formatter(data, 8, wordsize::BIT_32, format::FLOAT);
+        const auto s8  = MemoryFormatter::get_formatter(data, 12, wordsize::BIT_8, format::SIGNED);
+        const auto u8  = MemoryFormatter::get_formatter(data, 12, wordsize::BIT_8, format::HEX);
+        const auto u16 = MemoryFormatter::get_formatter(data, 13, wordsize::BIT_16, format::UNSIGNED, endianness::BIG);
+        const auto bit = MemoryFormatter::get_formatter(data, 12, wordsize::BIT_1, format::BIN, endianness::HOST, 1);
+
+        assert(std::get<double>(f64->value()) < -2.4 && std::get<double>(f64->value()) > -2.6);
+        assert(f64->value<int>() == -2);
+        assert(f32->value<float>() > 0.7F && f32->value<float>() < 0.8F);
+        assert(std::get<std::int64_t>(s8->value()) == -2);
+        assert(std::get<std::uint64_t>(u8->value()) == 0xFE);
+        assert(u8->raw() == 0xFE);
+        assert(std::get<std::uint64_t>(u16->value()) == 0x1234);
+        assert(std::get<bool>(bit->value()));
+        assert(bit->value<int>() == 1);
+
+        // string and value are consistent
+        assert(std::to_string(u16->value<unsigned>()) == u16->string());
+        assert(std::to_string(s8->value<int>()) == s8->string());
+    }
+
+    // columnar batch decode
+    {
+        constexpr std::size_t IMAGES = 100;
+        constexpr std::size_t STRIDE = 24;
+
+        std::vector<uint8_t> images(IMAGES * STRIDE);
+        for (std::size_t i = 0; i < IMAGES; ++i) {
+            auto *image = images.data() + i * STRIDE;
+
+            const auto s = static_cast<int16_t>(-100 * static_cast<int>(i));
+            const auto u = static_cast<uint32_t>(i * 1000);
+            const auto d = static_cast<double>(i) / 4;
+            std::memcpy(image, &s, sizeof(s));
+            std::memcpy(image + 2, &u, sizeof(u));
+            std::memcpy(image + 8, &d, sizeof(d));
+            image[16] = static_cast<uint8_t>(i);
+        }
+
+        // layout is defined on the first image
+        memformat::FormatterSet set;
+        set.add("s", images.data(), "0", wordsize::BIT_16, format::SIGNED);
+        set.add("u", images.data(), "2", wordsize::BIT_32, format::UNSIGNED);
+        set.add("d", images.data(), "8", wordsize::BIT_64, format::FLOAT);
+        set.add("b", images.data(), "16.2", wordsize::BIT_1);
+        set.add("x", images.data(), "2", wordsize::BIT_32, format::HEX, endianness::BIG);
+
+        const memformat::BatchDecoder decoder(set);
+        assert(decoder.get_image_size() == 17);
+        assert(decoder.fields()[3].type == memformat::BatchDecoder::value_type::BIT);
+
+        const auto columns = decoder.decode_all(images.data(), IMAGES, STRIDE);
+        assert(columns.size() == set.size());
+
+        const auto &s = std::get<std::vector<std::int64_t>>(columns[0]);
+        const auto &u = std::get<std::vector<std::uint64_t>>(columns[1]);
+        const auto &d = std::get<std::vector<double>>(columns[2]);
+        const auto &b = std::get<std::vector<std::uint8_t>>(columns[3]);
+        const auto &x = std::get<std::vector<std::uint64_t>>(columns[4]);
+
+        for (std::size_t i = 0; i < IMAGES; ++i) {
+            void *image = images.data() + i * STRIDE;
+            assert(s[i] == -100 * static_cast<std::int64_t>(i));
+            assert(u[i] == i * 1000);
+            assert(static_cast<std::size_t>(d[i] * 4) == i);
+            assert(b[i] == ((i >> 2) & 1));
+
+            // identical to the typed value accessor of the formatters
+            const auto formatter = memformat::MemoryFormatter::get_formatter(
+                    image, 2, wordsize::BIT_32, format::HEX, endianness::BIG);
+            assert(x[i] == std::get<std::uint64_t>(formatter->value()));
+        }
+
+        // conversion to another output type
+        std::vector<double> s_double(IMAGES);
+        decoder.decode(0, images.data(), IMAGES, STRIDE, s_double.data());
+        assert(static_cast<int>(s_double[7]) == -700);
+
+        bool thrown = false;
+        try {
+            decoder.decode(0, images.data(), IMAGES, 8, s_double.data());
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+}
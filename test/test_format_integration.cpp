@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatIntegration.hpp"
+#include "MemoryFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    alignas(8) uint8_t data[16] {};
+
+    const uint16_t u16 = 0xBEEF;
+    const int32_t  i32 = -42;
+    std::memcpy(data, &u16, sizeof(u16));
+    std::memcpy(data + 4, &i32, sizeof(i32));
+    data[8] = 0x05;
+
+    const auto hex = memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_16, format::HEX);
+    const auto sig = memformat::MemoryFormatter::get_formatter(data, 4, wordsize::BIT_32, format::SIGNED);
+    const auto bin = memformat::MemoryFormatter::get_formatter(data, 8, wordsize::BIT_8, format::BIN);
+    const auto oct = memformat::MemoryFormatter::get_formatter(data, 8, wordsize::BIT_8, format::OCT);
+
+    // format spec parsing and padding
+    memformat::detail::FormatSpec spec;
+    const std::string_view        str = "*^#9}";
+    assert(spec.parse(str.begin(), str.end()) == str.end() - 1);
+    assert(spec.fill == '*' && spec.align == '^' && spec.alternate && spec.width == 9);
+
+    std::string out;
+    spec.write(std::back_inserter(out), "beef", "0x");
+    assert(out == "*0xbeef**");
+
+    memformat::detail::FormatSpec zero;
+    const std::string_view        zero_str = "08";
+    zero.parse(zero_str.begin(), zero_str.end());
+    out.clear();
+    zero.write(std::back_inserter(out), "-42", {});
+    assert(out == "-0000042");
+
+#ifdef MEMFORMAT_FMT_FORMATTER
+    assert(fmt::format("{}", *hex) == "beef");
+    assert(fmt::format("{:#}", *hex) == "0xbeef");
+    assert(fmt::format("{:#010}", *hex) == "0x0000beef");
+    assert(fmt::format("[{:>8}]", *hex) == "[    beef]");
+    assert(fmt::format("[{:<8}]", *hex) == "[beef    ]");
+    assert(fmt::format("[{:_^8}]", *hex) == "[__beef__]");
+    assert(fmt::format("{:06}", *sig) == "-00042");
+    assert(fmt::format("{:#}", *bin) == "0b00000101");
+    assert(fmt::format("{:#}", *oct) == "05");
+    assert(fmt::format("{}={:#x}", "reg", 1) == "reg=0x1");
+    assert(fmt::format("{:>6}", hex->result()) == "  beef");
+
+    bool thrown = false;
+    try {
+        (void) fmt::format(fmt::runtime("{:x}"), *hex);
+    } catch (const fmt::format_error &) { thrown = true; }
+    assert(thrown);
+#endif
+
+#ifdef __cpp_lib_format
+    assert(std::format("{:#010}", *hex) == "0x0000beef");
+    assert(std::format("{:06}", *sig) == "-00042");
+    assert(std::format("[{:_^8}]", hex->result()) == "[__beef__]");
+#endif
+}
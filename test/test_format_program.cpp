@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatProgram.hpp"
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief check whether compiling a template throws std::invalid_argument
+ * @param pattern template
+ * @return true if the template is invalid
+ */
+static bool invalid(const char *pattern) {
+    try {
+        const memformat::FormatProgram program(pattern);
+    } catch (const std::invalid_argument &) { return true; }
+    return false;
+}
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+    using operation = memformat::FormatProgram::operation;
+
+    alignas(8) uint8_t data[32] {};
+
+    const uint32_t u32 = 0xBEEF;
+    const int16_t  i16 = -42;
+    const double   d   = 3.14159;
+    const float    f   = -2.5F;
+    std::memcpy(data, &u32, sizeof(u32));
+    std::memcpy(data + 4, &i16, sizeof(i16));
+    std::memcpy(data + 8, &d, sizeof(d));
+    std::memcpy(data + 16, &f, sizeof(f));
+    data[20] = 0x04;
+
+    memformat::FormatterSet set;
+    set.add("reg", data, "0", wordsize::BIT_32, format::UNSIGNED);
+    set.add("temp", data, "4", wordsize::BIT_16, format::SIGNED);
+    set.add("pi", data, "8", wordsize::BIT_64, format::FLOAT);
+    set.add("f", data, "16", wordsize::BIT_32, format::FLOAT);
+    set.add("flag", data, "20.2", wordsize::BIT_1);
+
+    // compilation
+    const memformat::FormatProgram program("{name}: 0x{hex:08} ({unsigned}) {{{value}}}");
+    const auto                    &ops = program.operations();
+    assert(ops.size() == 8);
+    assert(ops[0].type == operation::NAME);
+    assert(ops[1].type == operation::LITERAL);
+    assert(ops[2].type == operation::HEX);
+    assert(ops[2].width == 8 && ops[2].zero_pad && !ops[2].left_align);
+    assert(ops[7].type == operation::LITERAL);
+
+    assert(program.string(set[0]) == "reg: 0x0000beef (48879) {48879}");
+    assert(program.string(set[1]) == "temp: 0x0000ffd6 (65494) {-42}");
+
+    // conversions
+    assert(memformat::FormatProgram("{signed}").string(set[1]) == "-42");
+    assert(memformat::FormatProgram("{signed:06}").string(set[1]) == "-00042");
+    assert(memformat::FormatProgram("[{signed:6}]").string(set[1]) == "[   -42]");
+    assert(memformat::FormatProgram("[{signed:-6}]").string(set[1]) == "[-42   ]");
+    assert(memformat::FormatProgram("{HEX}").string(set[0]) == "BEEF");
+    assert(memformat::FormatProgram("{oct}").string(set[0]) == "137357");
+    assert(memformat::FormatProgram("{bin}").string(set[1]) == "1111111111010110");
+    assert(memformat::FormatProgram("{float:.3}").string(set[2]) == "3.142");
+    assert(memformat::FormatProgram("{float}").string(set[2]) == set[2].formatter->string());
+    assert(memformat::FormatProgram("{float:.1}").string(set[3]) == "-2.5");
+    assert(memformat::FormatProgram("{float:08.2}").string(set[3]) == "-0002.50");
+    assert(memformat::FormatProgram("{name:-6}|").string(set[2]) == "pi    |");
+    assert(memformat::FormatProgram("{name}={bin}/{unsigned}").string(set[4]) == "flag=1/1");
+    assert(memformat::FormatProgram("}}{{").string(set[0]) == "}{");
+    assert(memformat::FormatProgram("").string(set[0]).empty());
+
+    // float conversion of an integer word size
+    bool thrown = false;
+    try {
+        (void) memformat::FormatProgram("{float}").string(set[1]);
+    } catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+
+    // other base address
+    alignas(8) uint8_t other[32] {};
+    const uint32_t     other_u32 = 7;
+    std::memcpy(other, &other_u32, sizeof(other_u32));
+    std::vector<char> buffer(program.max_size(3));
+    const auto        end = program.format_to(other, buffer.data(), *set[0].formatter, "reg");
+    assert(std::string(buffer.data(), end) == "reg: 0x00000007 (7) {7}");
+
+    // whole set
+    std::string out;
+    memformat::FormatProgram("{name}={value}").append_to(out, set);
+    const auto expected = "reg=48879\ntemp=-42\npi=" + set[2].formatter->string() + "\nf=" +
+                          set[3].formatter->string() + "\nflag=1\n";
+    assert(out == expected);
+
+    // max size
+    assert(memformat::FormatProgram("ab{name}").max_size(5) == 7);
+    assert(memformat::FormatProgram("{hex:20}").max_size() == 20);
+
+    // invalid templates
+    assert(invalid("{"));
+    assert(invalid("}"));
+    assert(invalid("{name"));
+    assert(invalid("{unknown}"));
+    assert(invalid("{hex:x}"));
+    assert(invalid("{hex:.3}"));
+    assert(invalid("{float:.}"));
+    assert(invalid("{float:.999}"));
+    assert(invalid("{hex:99999}"));
+    assert(invalid("{name:05}"));
+}
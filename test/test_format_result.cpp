@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "MemoryFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    alignas(8) uint8_t data[8];
+
+    const uint64_t patterns[] = {0,
+                                 1,
+                                 0x8000000000000000,
+                                 0xFFFFFFFFFFFFFFFF,
+                                 0x0123456789ABCDEF,
+                                 0x7FEFFFFFFFFFFFFF,  // largest double
+                                 0xC5B4A3F2E1D0C0B0};
+
+    for (const auto pattern : patterns) {
+        std::memcpy(data, &pattern, sizeof(pattern));
+
+        for (const auto w : {wordsize::BIT_8, wordsize::BIT_16, wordsize::BIT_32, wordsize::BIT_64}) {
+            for (const auto f :
+                 {format::BIN, format::OCT, format::HEX, format::SIGNED, format::UNSIGNED, format::FLOAT}) {
+                if (f == format::FLOAT && (w == wordsize::BIT_8 || w == wordsize::BIT_16)) continue;
+
+                for (const auto e : {endianness::HOST, endianness::BIG, endianness::LITTLE}) {
+                    if (w == wordsize::BIT_8 && e != endianness::HOST) continue;
+
+                    const auto formatter = memformat::MemoryFormatter::get_formatter(data, 0, w, f, e);
+                    const auto result    = formatter->result();
+                    assert(result == formatter->string());
+                    assert(result.str() == formatter->string());
+                    assert(result.size() <= memformat::MAX_STRING_LENGTH);
+                }
+            }
+        }
+
+        for (std::size_t bit = 0; bit < 8; ++bit) {
+            const auto formatter = memformat::MemoryFormatter::get_formatter(
+                    data, 0, wordsize::BIT_1, format::BIN, endianness::HOST, bit);
+            assert(formatter->result() == formatter->string());
+        }
+    }
+
+    // conversion to std::string_view
+    const double value = -std::numeric_limits<double>::max();
+    std::memcpy(data, &value, sizeof(value));
+    const auto formatter = memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_64, format::FLOAT);
+    const auto result    = formatter->result();
+
+    const std::string_view view = result;
+    assert(view.size() == memformat::MAX_STRING_LENGTH);
+    assert(view.front() == '-');
+    assert(std::string(result.begin(), result.end()) == formatter->string());
+}
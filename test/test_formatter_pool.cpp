@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterPool.hpp"
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+#include "ReadPlan.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    uint8_t data[16] = {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0};
+
+    memformat::FormatterPool pool;
+
+    // identical arguments return the same instance
+    const auto a = pool.get(data, 0, wordsize::BIT_16, format::HEX, endianness::BIG);
+    const auto b = pool.get(data, "0", wordsize::BIT_16, format::HEX, endianness::BIG);
+    assert(a == b);
+    assert(a->string() == "1234");
+    assert(pool.size() == 1);
+
+    // different arguments
+    assert(pool.get(data, 0, wordsize::BIT_16, format::HEX, endianness::LITTLE) != a);
+    assert(pool.get(data, 2, wordsize::BIT_16, format::HEX, endianness::BIG) != a);
+    assert(pool.get(data + 1, 0, wordsize::BIT_16, format::HEX, endianness::BIG) != a);
+    assert(pool.get(data, 0, wordsize::BIT_16, format::UNSIGNED, endianness::BIG) != a);
+
+    // ignored arguments
+    const auto byte = pool.get(data, 1, wordsize::BIT_8, format::HEX, endianness::HOST);
+    assert(pool.get(data, 1, wordsize::BIT_8, format::HEX, endianness::BIG) == byte);
+    const auto bit = pool.get(data, "0.4", wordsize::BIT_1);
+    assert(pool.get(data, 0, wordsize::BIT_1, format::HEX, endianness::BIG, 4) == bit);
+    assert(pool.get(data, 0, wordsize::BIT_1, format::BIN, endianness::HOST, 5) != bit);
+
+    // the pool does not keep formatters alive
+    const auto in_use = pool.size();
+    {
+        const auto temporary = pool.get(data, 8, wordsize::BIT_64, format::HEX);
+        assert(pool.size() == in_use + 1);
+    }
+    assert(pool.size() == in_use);
+    pool.purge();
+    assert(pool.size() == in_use);
+    assert(pool.get(data, 0, wordsize::BIT_16, format::HEX, endianness::BIG) == a);
+
+    // invalid arguments
+    bool thrown = false;
+    try {
+        (void) pool.get(data, 0, wordsize::BIT_16, format::HEX, endianness::BIG_SWAP16);
+    } catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+    thrown = false;
+    try {
+        (void) pool.get(data, 0, wordsize::BIT_1, format::BIN, endianness::HOST, 8);
+    } catch (const std::out_of_range &) { thrown = true; }
+    assert(thrown);
+
+    // concurrent users get the same instance
+    constexpr std::size_t                                    THREADS = 4;
+    std::vector<std::shared_ptr<memformat::MemoryFormatter>> results(THREADS * 64);
+    std::vector<std::thread>                                 threads;
+    for (std::size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < 64; ++i)
+                results[t * 64 + i] = pool.get(data, i % 8, wordsize::BIT_8, format::UNSIGNED);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    for (std::size_t i = 0; i < results.size(); ++i)
+        assert(results[i] == results[i % 64]);
+
+    // the global pool (used by MemoryFormatter::get_formatter)
+    assert(memformat::FormatterPool::global().get(data, 4, wordsize::BIT_32, format::HEX) ==
+           memformat::FormatterPool::global().get(data, "4", wordsize::BIT_32, format::HEX));
+    const auto global = memformat::MemoryFormatter::get_formatter(data, 4, wordsize::BIT_32, format::HEX);
+    assert(global == memformat::FormatterPool::global().get(data, 4, wordsize::BIT_32, format::HEX));
+    assert(global == memformat::MemoryFormatter::get_formatter(data, "4", wordsize::BIT_32, format::HEX));
+    assert(global->relocate(data, 4) == global);
+
+    // expired entries are replaced and the tables grow (lookups of other threads run concurrently)
+    const auto before_churn = pool.size();
+    {
+        std::vector<std::shared_ptr<memformat::MemoryFormatter>> kept;
+        std::thread                                              reader([&] {
+            for (std::size_t i = 0; i < 10000; ++i) {
+                [[maybe_unused]] const auto found = pool.get(data, 0, wordsize::BIT_16, format::HEX, endianness::BIG);
+                assert(found == a);
+            }
+        });
+        for (std::size_t i = 0; i < 10000; ++i) {
+            auto formatter = pool.get(data + i % 8, i, wordsize::BIT_8, format::HEX);
+            assert(formatter->get_offset() == i);
+            if (i % 4 == 0) kept.push_back(std::move(formatter));
+        }
+        reader.join();
+        for (std::size_t i = 0; i < kept.size(); ++i) {
+            [[maybe_unused]] const auto found = pool.get(data + (i * 4) % 8, i * 4, wordsize::BIT_8, format::HEX);
+            assert(found == kept[i]);
+        }
+        assert(pool.size() == before_churn + kept.size());
+    }
+    pool.purge();
+    assert(pool.size() == before_churn);
+
+    // duplicate detection
+    memformat::FormatterSet set;
+    set.add("a", a);
+    set.add("byte", byte);
+    set.add("b", b);
+    set.add("other",
+            memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_16, format::HEX, endianness::BIG));
+    set.add("byte again", byte);
+
+    const auto first = set.duplicates();
+    assert((first == std::vector<std::size_t> {0, 1, 0, 3, 1}));
+
+    const auto unique = set.unique();
+    assert(unique.size() == 3);
+    assert(unique[0].name == "a");
+    assert(unique[1].name == "byte");
+    assert(unique[2].name == "other");
+
+    // snapshot sets keep the sharing ("a" and "other" are relocated to the same formatter of the global pool)
+    const std::vector<std::size_t> merged {0, 1, 0, 0, 1};
+    uint8_t                        copy[16];
+    std::memcpy(copy, data, sizeof(copy));
+    const auto rebound = set.rebind(copy);
+    assert(rebound.duplicates() == merged);
+    assert(rebound[2].formatter->string() == "1234");
+
+    const memformat::ReadPlan plan(set);
+    uint8_t                   buffer[16];
+    plan.copy(buffer);
+    const auto bound = plan.bind(buffer);
+    assert(bound.duplicates() == merged);
+    assert(bound[2].name == "b");
+    assert(bound[2].formatter->string() == "1234");
+    assert(bound[4].formatter->string() == "34");
+}
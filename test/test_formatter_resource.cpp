@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+#include "OutputSink.hpp"
+
+#include <cassert>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief memory resource that counts allocations
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+private:
+    std::pmr::memory_resource *upstream = std::pmr::new_delete_resource();
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+int main() {
+    alignas(8) uint8_t data[64] {};
+    data[0] = 0x05;
+    data[8] = 0x2A;
+
+    // handles return their memory to the resource
+    {
+        CountingResource resource;
+        {
+            auto bits = memformat::MemoryFormatter::get_formatter(resource, data, "0.2", memformat::wordsize::BIT_1);
+            auto u16  = memformat::MemoryFormatter::get_formatter(
+                    resource, data, 8, memformat::wordsize::BIT_16, memformat::format::UNSIGNED);
+            assert(bits->string() == "1");
+            assert(u16->string() == "42");
+            assert(resource.allocations == 2);
+        }
+        assert(resource.deallocations == 2);
+
+        // invalid arguments do not leak memory
+        bool thrown = false;
+        try {
+            static_cast<void>(memformat::MemoryFormatter::get_formatter(
+                    resource, data, 0, memformat::wordsize::BIT_8, memformat::format::FLOAT));
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+        assert(resource.allocations == resource.deallocations);
+    }
+
+    // formatters in contiguous memory, used by a formatter set without reference counting
+    {
+        CountingResource                    upstream;
+        std::pmr::monotonic_buffer_resource arena(4096, &upstream);
+
+        std::vector<memformat::FormatterHandle> formatters;
+        memformat::FormatterSet                 set;
+        for (std::size_t i = 0; i < 32; ++i) {
+            formatters.push_back(memformat::MemoryFormatter::get_formatter(
+                    arena, data, i, memformat::wordsize::BIT_8, memformat::format::UNSIGNED));
+            set.add_unowned("v" + std::to_string(i), *formatters.back());
+        }
+        assert(upstream.allocations == 1);
+        assert(set[0].formatter.use_count() == 0);
+
+        const auto copy = set;
+        assert(copy[8].formatter.get() == formatters[8].get());
+
+        memformat::JsonArraySink sink(set);
+        const auto              &json = sink.render();
+        assert(json.substr(0, 9) == "[5,0,0,0,");
+        assert(json.find(",42,") != std::string::npos);
+    }
+}
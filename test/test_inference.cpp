@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "endian.hpp"
+#include "Inference.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+int main() {
+    // word swapped big endian floats
+    {
+        std::vector<uint32_t> data;
+        for (int i = 0; i < 256; ++i) {
+            const float value = 20.0f + static_cast<float>(i) / 32.0f;
+            uint32_t    raw;
+            std::memcpy(&raw, &value, sizeof(raw));
+            raw = ::endian::host_to_big(raw);
+
+            uint16_t words[2];
+            std::memcpy(words, &raw, sizeof(raw));
+            std::swap(words[0], words[1]);
+            std::memcpy(&raw, words, sizeof(raw));
+            data.push_back(raw);
+        }
+
+        memformat::InferenceHint hint;
+        hint.min = 1;
+        hint.max = 100;
+
+        const auto result = memformat::infer_interpretations(data.data(), data.size() * sizeof(uint32_t), hint);
+        assert(!result.empty());
+
+        const auto &best = result.front();
+        assert(best.word_size == memformat::wordsize::BIT_32);
+        assert(best.endian == memformat::endianness::BIG_SWAP16);
+        assert(best.output_format == memformat::format::FLOAT);
+        assert(best.samples == 256);
+        assert(best.matches == best.samples);
+        assert(best.min >= 20.0 && best.min < 20.01);
+        assert(best.max > 27.9 && best.max < 28.0);
+
+        // no other floating point interpretation is plausible
+        for (std::size_t i = 1; i < result.size(); ++i)
+            assert(result[i].output_format != memformat::format::FLOAT || result[i].matches <= result[i].samples / 2);
+    }
+
+    // big endian 16 bit counter
+    {
+        std::vector<uint16_t> data;
+        for (uint16_t i = 0; i < 64; ++i)
+            data.push_back(::endian::host_to_big(static_cast<uint16_t>(1000 + i)));
+
+        memformat::InferenceHint hint;
+        hint.min        = 0;
+        hint.max        = 5000;
+        hint.word_sizes = {memformat::wordsize::BIT_16};
+        hint.formats    = {memformat::format::UNSIGNED};
+
+        const auto result = memformat::infer_interpretations(data.data(), data.size() * sizeof(uint16_t), hint);
+        assert(result.size() == 2);
+        assert(result[0].endian == memformat::endianness::BIG);
+        assert(result[0].matches == 64);
+        assert(static_cast<int>(result[0].min) == 1000 && static_cast<int>(result[0].max) == 1063);
+        assert(result[1].endian == memformat::endianness::LITTLE);
+        assert(result[1].matches < result[1].samples / 2);
+
+        // values with a stride (every second value)
+        hint.stride = 4;
+        const auto strided = memformat::infer_interpretations(data.data(), data.size() * sizeof(uint16_t), hint);
+        assert(strided[0].samples == 32);
+        assert(static_cast<int>(strided[0].max) == 1062);
+    }
+
+    // invalid hints
+    {
+        uint8_t data[8] {};
+
+        memformat::InferenceHint hint;
+        hint.formats = {memformat::format::HEX};
+
+        bool thrown = false;
+        try {
+            static_cast<void>(memformat::infer_interpretations(data, sizeof(data), hint));
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+
+        hint     = {};
+        hint.min = 1;
+        hint.max = 0;
+
+        thrown = false;
+        try {
+            static_cast<void>(memformat::infer_interpretations(data, sizeof(data), hint));
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+}
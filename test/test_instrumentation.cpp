@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+#include "Instrumentation.hpp"
+#include "MemoryFormatter.hpp"
+#include "MultiImageFormatter.hpp"
+#include "OutputSink.hpp"
+#include "StringFormatter.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int main() {
+    namespace instrumentation = memformat::instrumentation;
+
+    alignas(8) uint8_t data[16] {};
+    data[0] = 0xFF;
+
+    auto bin8  = memformat::MemoryFormatter::get_formatter(data, "0", memformat::wordsize::BIT_8);
+    auto flt64 = memformat::MemoryFormatter::get_formatter(
+            data, "8", memformat::wordsize::BIT_64, memformat::format::FLOAT);
+
+    instrumentation::reset();
+
+    std::string out;
+    for (int i = 0; i < 10; ++i)
+        bin8->append_to(out);
+    flt64->append_to(out);
+    assert(out.size() == 10 * 8 + 8);
+
+    const auto  snapshot = instrumentation::snapshot();
+    const auto &c_bin8   = snapshot.get(memformat::wordsize::BIT_8, memformat::format::BIN);
+    const auto &c_flt64  = snapshot.get(memformat::wordsize::BIT_64, memformat::format::FLOAT);
+    const auto  total    = snapshot.total();
+    const auto  text     = instrumentation::prometheus_text(snapshot);
+
+    if constexpr (instrumentation::ENABLED) {
+        assert(c_bin8.calls == 10);
+        assert(c_bin8.bytes_read == 10);
+        assert(c_bin8.bytes_written == 80);
+        assert(c_flt64.calls == 1);
+        assert(c_flt64.bytes_read == 8);
+        assert(c_flt64.bytes_written == 8);
+        assert(total.calls == 11);
+
+        std::uint64_t histogram = 0;
+        for (auto bucket : total.histogram)
+            histogram += bucket;
+        assert(histogram == 11);
+
+        assert(text.find("memformat_format_calls_total{wordsize=\"8\",format=\"bin\"} 10\n") != std::string::npos);
+        assert(text.find("memformat_format_duration_nanoseconds_bucket{wordsize=\"64\",format=\"float\",le=\"+Inf\"} "
+                         "1\n") != std::string::npos);
+        assert(text.find("memformat_format_duration_nanoseconds_count{wordsize=\"8\",format=\"bin\"} 10\n") !=
+               std::string::npos);
+        assert(text.find("format=\"hex\"") == std::string::npos);
+
+        instrumentation::reset();
+        assert(instrumentation::snapshot().total().calls == 0);
+
+        // string() is counted as well
+        for (int i = 0; i < 5; ++i)
+            assert(bin8->string() == "11111111");
+        const auto  string_snapshot = instrumentation::snapshot();
+        const auto &c_string        = string_snapshot.get(memformat::wordsize::BIT_8, memformat::format::BIN);
+        assert(c_string.calls == 5);
+        assert(c_string.bytes_written == 40);
+
+        // character fields count the bytes of the field
+        data[0] = 'A';
+        assert(memformat::get_string_formatter(data, 0, 12)->string() == "A");
+        const auto &c_field = instrumentation::snapshot().get(memformat::wordsize::BIT_8, memformat::format::STRING);
+        assert(c_field.calls == 1);
+        assert(c_field.bytes_read == 12);
+        assert(c_field.bytes_written == 1);
+    } else {
+        assert(total.calls == 0);
+        assert(text.find("memformat_format_calls_total{") == std::string::npos);
+        assert(text.find("# TYPE memformat_format_calls_total counter\n") != std::string::npos);
+    }
+
+    // entries that share a formatter instance are formatted once per render
+    alignas(8) uint8_t image[16] {0x12, 0x34};
+    const double       nan = std::nan("");
+    std::memcpy(image + 8, &nan, sizeof(nan));
+
+    memformat::FormatterSet set;
+    set.add("a", image, "0", memformat::wordsize::BIT_16, memformat::format::HEX, memformat::endianness::BIG);
+    set.add("nan", image, "8", memformat::wordsize::BIT_64, memformat::format::FLOAT);
+    set.add("b", image, "0", memformat::wordsize::BIT_16, memformat::format::HEX, memformat::endianness::BIG);
+    set.add("nan again", image, "8", memformat::wordsize::BIT_64, memformat::format::FLOAT);
+    set.add("other", image, "0", memformat::wordsize::BIT_16, memformat::format::HEX, memformat::endianness::LITTLE);
+    assert((set.duplicates() == std::vector<std::size_t> {0, 1, 0, 1, 4}));
+
+    memformat::JsonObjectSink   json(set);
+    memformat::JsonArraySink    array(set);
+    memformat::CsvRowSink       csv(set);
+    memformat::LineProtocolSink line(set, "m");
+
+    const auto expect_calls = [&](std::uint64_t hex16, std::uint64_t float64) {
+        const auto  counters = instrumentation::snapshot();
+        const auto &hex      = counters.get(memformat::wordsize::BIT_16, memformat::format::HEX);
+        const auto &flt      = counters.get(memformat::wordsize::BIT_64, memformat::format::FLOAT);
+        if constexpr (instrumentation::ENABLED) {
+            assert(hex.calls == hex16);
+            assert(flt.calls == float64);
+        } else {
+            assert(hex.calls == 0 && flt.calls == 0);
+            (void) hex16;
+            (void) float64;
+        }
+        instrumentation::reset();
+    };
+
+    const auto nan_text = set[1].formatter->string();
+
+    instrumentation::reset();
+    [[maybe_unused]] const auto json_out = json.render();
+    assert(json_out == R"({"a":"1234","nan":null,"b":"1234","nan again":null,"other":"3412"})");
+    expect_calls(2, 1);
+
+    [[maybe_unused]] const auto array_out = array.render();
+    assert(array_out == R"(["1234",null,"1234",null,"3412"])");
+    expect_calls(2, 1);
+
+    [[maybe_unused]] const auto csv_out = csv.render();
+    assert(csv_out == "1234," + nan_text + ",1234," + nan_text + ",3412\n");
+    expect_calls(2, 1);
+
+    [[maybe_unused]] const auto line_out = line.render();
+    assert(line_out == "m a=\"1234\",b=\"1234\",other=\"3412\"\n");
+    expect_calls(2, 1);
+
+    // every image is formatted once per instance (in both iteration orders)
+    alignas(8) uint8_t second[16] {0x56, 0x78};
+    std::memcpy(second + 8, &nan, sizeof(nan));
+    const std::vector<volatile void *> images {image, second};
+
+    const memformat::MultiImageFormatter multi(set);
+    for (const auto o : {memformat::MultiImageFormatter::order::IMAGE_MAJOR,
+                         memformat::MultiImageFormatter::order::LAYOUT_MAJOR}) {
+        std::vector<std::vector<std::string>> values(images.size(), std::vector<std::string>(set.size()));
+        multi.format(
+                images,
+                [&](std::size_t i, std::size_t index, std::string_view value) { values[i][index] = value; },
+                o);
+        assert(values[0][0] == "1234" && values[0][2] == "1234" && values[0][4] == "3412");
+        assert(values[1][0] == "5678" && values[1][2] == "5678" && values[1][4] == "7856");
+        assert(values[0][3] == values[0][1] && values[1][3] == values[1][1]);
+        expect_calls(4, 2);
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "LayoutCache.hpp"
+#include "StringFormatter.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    char path[] = "/tmp/memformat_layout_XXXXXX";
+    int  fd     = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    alignas(8) uint8_t data[64] {};
+    data[0x10] = 0x12;
+    data[0x11] = 0x34;
+    data[0x20] = 0x08;
+
+    memformat::FormatterSet set;
+    set.add("counter", data, "0x10", wordsize::BIT_16, format::HEX, endianness::BIG);
+    set.add("flag", data, "0x20.3", wordsize::BIT_1);
+    set.add("value", data, "0x28", wordsize::BIT_64, format::FLOAT, endianness::LITTLE_SWAP32);
+    set.add("", data, "0x30", wordsize::BIT_8, format::SIGNED);
+    set.add("counter again", set[0].formatter);
+    set.set_access(memformat::memory_access::ACQUIRE);
+
+    memformat::LayoutCache::write(path, set);
+
+    {
+        const memformat::LayoutCache cache(path);
+        assert(cache.size() == 5);
+        assert(cache.get_access() == memformat::memory_access::ACQUIRE);
+        assert(cache.entry(4).first == 0);
+        assert(cache.entry(2).first == 2);
+
+        const auto entry = cache.entry(2);
+        assert(entry.name == "value");
+        assert(entry.offset == 0x28);
+        assert(entry.w == wordsize::BIT_64);
+        assert(entry.f == format::FLOAT);
+        assert(entry.e == endianness::LITTLE_SWAP32);
+        assert(cache.entry(1).bit_index == 3);
+        assert(cache.entry(3).name.empty());
+
+        // the formatters can read from another base address
+        alignas(8) uint8_t other[64] {};
+        other[0x10] = 0xab;
+        other[0x11] = 0xcd;
+
+        const auto loaded = cache.create(data);
+        assert(loaded.size() == set.size());
+        for (std::size_t i = 0; i < set.size(); ++i) {
+            assert(loaded[i].name == set[i].name);
+            assert(loaded[i].formatter->string() == set[i].formatter->string());
+            assert(loaded[i].formatter->get_offset() == set[i].formatter->get_offset());
+        }
+        assert(loaded[1].formatter->string() == "1");
+
+        // access semantics and shared instances are restored
+        assert(loaded.get_access() == memformat::memory_access::ACQUIRE);
+        assert(loaded.duplicates() == set.duplicates());
+        assert(loaded[4].formatter == loaded[0].formatter);
+        assert(cache.formatter(0, other)->string() == "abcd");
+
+        bool thrown = false;
+        try {
+            (void) cache.entry(5);
+        } catch (const std::out_of_range &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // corrupt content is detected by the checksum
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(48 + 8);
+        file.put('\x7f');
+    }
+    bool thrown = false;
+    try {
+        const memformat::LayoutCache cache(path);
+    } catch (const std::runtime_error &) { thrown = true; }
+    assert(thrown);
+
+    // ... unless verification is disabled: invalid entries are detected on access
+    {
+        const memformat::LayoutCache cache(path, false);
+        thrown = false;
+        try {
+            (void) cache.entry(0);
+        } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // truncated file
+    memformat::LayoutCache::write(path, set);
+    assert(truncate(path, 48 + 24) == 0);
+    thrown = false;
+    try {
+        const memformat::LayoutCache cache(path);
+    } catch (const std::runtime_error &) { thrown = true; }
+    assert(thrown);
+
+    // empty set
+    memformat::LayoutCache::write(path, memformat::FormatterSet());
+    assert(memformat::LayoutCache(path).size() == 0);
+
+    // formatters that can not be stored
+    memformat::FormatterSet custom;
+    custom.add("name", memformat::get_string_formatter(data, 0, 8));
+    thrown = false;
+    try {
+        memformat::LayoutCache::write(path, custom);
+    } catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+
+    uint8_t                 data2[8] {};
+    memformat::FormatterSet mixed;
+    mixed.add("a", data, "0", wordsize::BIT_8);
+    mixed.add("b", data2, "0", wordsize::BIT_8);
+    thrown = false;
+    try {
+        memformat::LayoutCache::write(path, mixed);
+    } catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+
+    // the failed writes did not replace the file
+    assert(memformat::LayoutCache(path).size() == 0);
+
+    std::remove(path);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "MemoryFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <locale>
+#include <string>
+
+//* numeric punctuation with decimal comma and digit grouping
+class GroupingPunct : public std::numpunct<char> {
+protected:
+    char        do_decimal_point() const override { return ','; }
+    char        do_thousands_sep() const override { return '.'; }
+    std::string do_grouping() const override { return "\3"; }
+};
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    std::locale::global(std::locale(std::locale::classic(), new GroupingPunct));
+
+    alignas(8) uint8_t data[8];
+
+    const uint32_t u32 = 1234567;
+    std::memcpy(data, &u32, sizeof(u32));
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_32, format::UNSIGNED)->string() ==
+           "1234567");
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_32, format::HEX)->string() == "12d687");
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_32, format::OCT)->string() == "4553207");
+
+    const int64_t i64 = -9876543210;
+    std::memcpy(data, &i64, sizeof(i64));
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_64, format::SIGNED)->string() ==
+           "-9876543210");
+
+    const double d = 12345.5;
+    std::memcpy(data, &d, sizeof(d));
+    const auto fd = memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_64, format::FLOAT);
+    assert(fd->string() == "12345.500000");
+    assert(std::string(fd->result().view()) == fd->string());
+
+    const float f = 0.25F;
+    std::memcpy(data, &f, sizeof(f));
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_32, format::FLOAT)->string() ==
+           "0.250000");
+
+    const uint16_t u16 = 0x0105;
+    std::memcpy(data, &u16, sizeof(u16));
+    assert(memformat::MemoryFormatter::get_formatter(data, 0, wordsize::BIT_16, format::BIN)->string() ==
+           "0000000100000101");
+
+    std::locale::global(std::locale::classic());
+}
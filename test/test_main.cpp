@@ -3,7 +3,7 @@
  * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
  */
 
-#include "../src/endian.hpp"
+#include "endian.hpp"
 #include "MemoryFormatter.hpp"
 
 #include <cassert>
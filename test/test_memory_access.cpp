@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+#include "ReadPlan.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::memory_access;
+    using memformat::wordsize;
+
+    alignas(16) uint8_t data[64];
+    for (std::size_t i = 0; i < sizeof(data); ++i)
+        data[i] = static_cast<uint8_t>(0x5B * i + 0x17);
+
+    const memory_access policies[] = {
+            memory_access::VOLATILE, memory_access::PLAIN, memory_access::RELAXED, memory_access::ACQUIRE};
+    const wordsize sizes[] = {wordsize::BIT_8, wordsize::BIT_16, wordsize::BIT_32, wordsize::BIT_64};
+    const format   formats[] = {format::UNSIGNED, format::SIGNED, format::HEX};
+
+    // every policy produces the same output (aligned and unaligned offsets)
+    for (const auto w : sizes) {
+        for (const auto f : formats) {
+            for (std::size_t offset = 0; offset < 8; ++offset) {
+                const auto formatter = memformat::MemoryFormatter::get_formatter(data, offset, w, f, endianness::BIG);
+                const auto expected  = formatter->string();
+                const auto raw       = formatter->raw();
+
+                for (const auto access : policies) {
+                    assert(formatter->result(data, access) == expected);
+                    assert(formatter->raw(data, access) == raw);
+                    assert(formatter->result(data + 1, access) == formatter->result(data + 1));
+                }
+            }
+        }
+    }
+
+    // bit formatter
+    for (const auto access : policies) {
+        const auto bit =
+                memformat::MemoryFormatter::get_formatter(data, 2, wordsize::BIT_1, format::BIN, endianness::HOST, 3);
+        assert(bit->result(data, access) == std::to_string((data[2] >> 3) & 1));
+    }
+
+    // set wide policy
+    memformat::FormatterSet set;
+    set.add("a", data, "4", wordsize::BIT_32, format::UNSIGNED);
+    set.add("b", data, "9", wordsize::BIT_16, format::HEX);
+    assert(set.get_access() == memory_access::VOLATILE);
+    set.set_access(memory_access::ACQUIRE);
+    assert(set.get_access() == memory_access::ACQUIRE);
+
+    // copies share the formatters, but not the access semantics
+    auto shared = set;
+    shared.set_access(memory_access::RELAXED);
+    assert(shared[0].formatter == set[0].formatter);
+    assert(set.get_access() == memory_access::ACQUIRE);
+
+    // sets without duplicates keep the access semantics
+    assert(set.unique().get_access() == memory_access::ACQUIRE);
+    assert(shared.unique().get_access() == memory_access::RELAXED);
+
+    // snapshot sets use plain loads
+    uint8_t    copy[64];
+    const auto region = set.region();
+    for (std::size_t i = 0; i < region.size; ++i)
+        copy[i] = data[4 + i];
+    const auto rebound = set.rebind(copy);
+    assert(rebound.get_access() == memory_access::PLAIN);
+    assert(set.get_access() == memory_access::ACQUIRE);
+    for (std::size_t i = 0; i < set.size(); ++i)
+        assert(rebound[i].formatter->string() == set[i].formatter->string());
+
+    const memformat::ReadPlan plan(set);
+    uint8_t                   buffer[64];
+    plan.copy(buffer);
+    const auto bound = plan.bind(buffer);
+    assert(bound.get_access() == memory_access::PLAIN);
+    for (std::size_t i = 0; i < set.size(); ++i)
+        assert(bound[i].formatter->string() == set[i].formatter->string());
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "MultiImageFormatter.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+    using order = memformat::MultiImageFormatter::order;
+
+    constexpr std::size_t IMAGES     = 37;
+    constexpr std::size_t IMAGE_SIZE = 16;
+
+    std::vector<uint8_t>         storage(IMAGES * IMAGE_SIZE);
+    std::vector<volatile void *> images;
+    for (std::size_t i = 0; i < IMAGES; ++i) {
+        auto *image = storage.data() + i * IMAGE_SIZE;
+        image[0]    = static_cast<uint8_t>(i);
+        image[1]    = static_cast<uint8_t>(1 << (i % 8));
+
+        const auto value = static_cast<uint32_t>(100000 + i);
+        std::memcpy(image + 4, &value, sizeof(value));
+        images.push_back(image);
+    }
+
+    // layout is defined on the first image
+    memformat::FormatterSet set;
+    set.add("id", storage.data(), "0", wordsize::BIT_8, format::UNSIGNED);
+    set.add("bit3", storage.data(), "1.3", wordsize::BIT_1);
+    set.add("counter", storage.data(), "4", wordsize::BIT_32, format::UNSIGNED, endianness::HOST);
+
+    const memformat::MultiImageFormatter layout(set);
+    assert(layout.size() == 3);
+    assert(layout.get_image_size() == 8);
+
+    const auto expected = [](std::size_t image, std::size_t index) -> std::string {
+        switch (index) {
+            case 0: return std::to_string(image);
+            case 1: return image % 8 == 3 ? "1" : "0";
+            default: return std::to_string(100000 + image);
+        }
+    };
+
+    // iteration order (single thread)
+    for (const auto o : {order::IMAGE_MAJOR, order::LAYOUT_MAJOR}) {
+        std::vector<std::pair<std::size_t, std::size_t>> visited;
+        const auto callback = [&](std::size_t image, std::size_t index, std::string_view value) {
+            assert(value == expected(image, index));
+            visited.emplace_back(image, index);
+        };
+        layout.format(images, callback, o);
+
+        assert(visited.size() == IMAGES * layout.size());
+        if (o == order::IMAGE_MAJOR) {
+            assert(visited[1].first == 0 && visited[1].second == 1);
+            assert(visited[3].first == 1 && visited[3].second == 0);
+        } else {
+            assert(visited[1].first == 1 && visited[1].second == 0);
+            assert(visited[IMAGES].first == 0 && visited[IMAGES].second == 1);
+        }
+    }
+
+    // parallel
+    for (const unsigned threads : {0U, 2U, 4U, 64U}) {
+        std::vector<std::atomic<int>> seen(IMAGES * layout.size());
+        const auto callback = [&](std::size_t image, std::size_t index, std::string_view value) {
+            assert(value == expected(image, index));
+            ++seen[image * layout.size() + index];
+        };
+        layout.format(images, callback, order::LAYOUT_MAJOR, threads);
+
+        for (const auto &s : seen)
+            assert(s == 1);
+    }
+
+    // exceptions are forwarded
+    const auto throwing = [](std::size_t image, std::size_t, std::string_view) {
+        if (image == IMAGES - 1) throw std::runtime_error("callback");
+    };
+
+    bool thrown = false;
+    try {
+        layout.format(images, throwing, order::IMAGE_MAJOR, 4);
+    } catch (const std::runtime_error &) { thrown = true; }
+    assert(thrown);
+}
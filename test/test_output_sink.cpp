@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+int main() {
+    alignas(8) uint8_t data[32] {};
+
+    const uint8_t  d8      = 0b10010011;
+    const int16_t  d16     = -1234;
+    const uint32_t d32     = 4000000100;
+    const float    d_float = 42.5f;
+
+    data[0] = d8;
+    std::memcpy(data + 2, &d16, sizeof(d16));
+    std::memcpy(data + 4, &d32, sizeof(d32));
+    std::memcpy(data + 8, &d_float, sizeof(d_float));
+
+    memformat::FormatterSet set;
+    set.add("bit", data, "0.1", memformat::wordsize::BIT_1);
+    set.add("bin", data, "0", memformat::wordsize::BIT_8, memformat::format::BIN);
+    set.add("signed \"16\"", data, "2", memformat::wordsize::BIT_16, memformat::format::SIGNED);
+    set.add("unsigned,32", data, "4", memformat::wordsize::BIT_32, memformat::format::UNSIGNED);
+    set.add("float", data, "8", memformat::wordsize::BIT_32, memformat::format::FLOAT);
+    assert(set.size() == 5);
+
+    // format_to/append_to produce the same output as string()
+    for (const auto &entry : set) {
+        std::string str;
+        entry.formatter->append_to(str);
+        assert(str == entry.formatter->string());
+    }
+
+    // json object
+    memformat::JsonObjectSink json_object(set);
+    assert(json_object.render() ==
+           R"({"bit":1,"bin":"10010011","signed \"16\"":-1234,"unsigned,32":4000000100,"float":42.500000})");
+
+    // json array
+    memformat::JsonArraySink json_array(set);
+    assert(json_array.render() == R"([1,"10010011",-1234,4000000100,42.500000])");
+
+    // buffer is reused and reflects the current memory content
+    data[0] = 0b10;
+    assert(json_array.render() == R"([1,"00000010",-1234,4000000100,42.500000])");
+
+    // csv
+    memformat::CsvRowSink csv(set);
+    assert(csv.header() == "bit,bin,\"signed \"\"16\"\"\",\"unsigned,32\",float\n");
+    assert(csv.render() == "1,00000010,-1234,4000000100,42.500000\n");
+
+    memformat::CsvRowSink csv_semicolon(set, ';');
+    assert(csv_semicolon.header() == "bit;bin;\"signed \"\"16\"\"\";unsigned,32;float\n");
+
+    // line protocol
+    memformat::LineProtocolSink line(set, "dev ice", {{"host", "a,b"}});
+    assert(line.render() == "dev\\ ice,host=a\\,b bit=true,bin=\"00000010\",signed\\ \"16\"=-1234i,"
+                            "unsigned\\,32=4000000100u,float=42.500000\n");
+    assert(line.render(1700000010000000100) == "dev\\ ice,host=a\\,b bit=true,bin=\"00000010\",signed\\ \"16\"=-1234i,"
+                                               "unsigned\\,32=4000000100u,float=42.500000 1700000010000000100\n");
+
+    // non-finite floats
+    const float nan = std::nanf("");
+    std::memcpy(data + 8, &nan, sizeof(nan));
+    memformat::FormatterSet float_set;
+    float_set.add("f", data, "8", memformat::wordsize::BIT_32, memformat::format::FLOAT);
+    float_set.add("u", data, "0", memformat::wordsize::BIT_8, memformat::format::UNSIGNED);
+    assert(memformat::JsonObjectSink(float_set).render() == R"({"f":null,"u":2})");
+    assert(memformat::LineProtocolSink(float_set, "m").render() == "m u=2u\n");
+
+    memformat::FormatterSet nan_set;
+    nan_set.add("f", data, "8", memformat::wordsize::BIT_32, memformat::format::FLOAT);
+    memformat::LineProtocolSink nan_line(nan_set, "m");
+    assert(nan_line.render().empty());
+    assert(nan_line.render(7).empty());
+
+    // empty set
+    memformat::FormatterSet empty;
+    assert(memformat::JsonObjectSink(empty).render() == "{}");
+    assert(memformat::JsonArraySink(empty).render() == "[]");
+    bool thrown = false;
+    try {
+        memformat::LineProtocolSink empty_line(empty, "m");
+    } catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "ProcessReader.hpp"
+
+#include <cassert>
+#include <csignal>
+#include <cstring>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+int main() {
+#ifdef OS_LINUX
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    alignas(8) static uint8_t data[4096];
+    for (std::size_t i = 0; i < sizeof(data); ++i)
+        data[i] = static_cast<uint8_t>(i);
+
+    const uint32_t value = 123456789;
+    std::memcpy(data + 2000, &value, sizeof(value));
+
+    memformat::FormatterSet set;
+    set.add("a", data, "0", wordsize::BIT_8, format::UNSIGNED);
+    set.add("b", data, "1", wordsize::BIT_16, format::HEX, endianness::BIG);     // adjacent to a
+    set.add("c", data, "2.1", wordsize::BIT_1);                                  // adjacent to b
+    set.add("d", data, "2", wordsize::BIT_32, format::HEX);                      // overlaps c
+    set.add("e", data, "2000", wordsize::BIT_32, format::UNSIGNED);              // separate range
+    set.add("f", data, "3000", wordsize::BIT_64, format::HEX, endianness::BIG);  // separate range
+
+    // child process with a copy of the memory
+    const auto child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        pause();
+        _exit(0);
+    }
+
+    // modify the local memory after the fork: the reader must return the memory of the child
+    data[0] = 0xFF;
+
+    memformat::ProcessReader reader(child, set);
+    assert(reader.ranges().size() == 3);
+    assert(reader.ranges()[0].size == 6);
+    assert(reader.size() == 6 + 4 + 8);
+
+    bool permitted = true;
+    try {
+        reader.read();
+    } catch (const std::system_error &e) {
+        // reading another process might be forbidden (e.g. Yama ptrace scope or seccomp)
+        assert(e.code().value() == EPERM || e.code().value() == ENOSYS);
+        permitted = false;
+    }
+
+    if (permitted) {
+        const auto &formatters = reader.formatters();
+        assert(formatters[0].name == "a");
+        assert(formatters[0].formatter->string() == "0");
+        assert(formatters[1].formatter->string() == "102");
+        assert(formatters[2].formatter->string() == "1");
+        assert(formatters[3].formatter->string() == set[3].formatter->string());
+        assert(formatters[4].formatter->string() == "123456789");
+        assert(formatters[5].formatter->string() == set[5].formatter->string());
+    }
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+
+    // process does not exist anymore
+    bool thrown = false;
+    try {
+        reader.read();
+    } catch (const std::system_error &) { thrown = true; }
+    assert(thrown);
+#endif
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+#include "ReadPlan.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    alignas(8) uint8_t data[256];
+    for (std::size_t i = 0; i < sizeof(data); ++i)
+        data[i] = static_cast<uint8_t>(i * 7);
+
+    // added in a different order than the memory layout
+    memformat::FormatterSet set;
+    set.add("d", data, "100", wordsize::BIT_64, format::HEX, endianness::BIG);  // 100..107
+    set.add("a", data, "0", wordsize::BIT_16, format::UNSIGNED);               // 0..1
+    set.add("b", data, "2", wordsize::BIT_32, format::HEX);                    // 2..5 (adjacent to a)
+    set.add("c", data, "4.3", wordsize::BIT_1);                                // 4 (inside b)
+    set.add("e", data, "10", wordsize::BIT_8, format::SIGNED);                 // 10 (gap of 4 bytes)
+    set.add("f", data, "200", wordsize::BIT_32, format::FLOAT);                // 200..203
+
+    // only overlapping and adjacent values are merged
+    {
+        const memformat::ReadPlan plan(set);
+        const auto               &ranges = plan.ranges();
+        assert(ranges.size() == 4);
+        assert(ranges[0].address == reinterpret_cast<std::uintptr_t>(data) && ranges[0].size == 6);
+        assert(ranges[1].address == reinterpret_cast<std::uintptr_t>(data + 10) && ranges[1].size == 1);
+        assert(ranges[2].size == 8 && ranges[3].size == 4);
+        assert(ranges[1].buffer_offset == 6 && ranges[2].buffer_offset == 7 && ranges[3].buffer_offset == 15);
+        assert(plan.buffer_size() == 19);
+        assert(plan.gap_bytes() == 0);
+        assert(plan.buffer_offset(0) == 7);
+        assert(plan.buffer_offset(3) == 4);
+    }
+
+    // gap threshold
+    for (const std::size_t max_gap : {std::size_t {0}, std::size_t {4}, std::size_t {100}, std::size_t {1000}}) {
+        const memformat::ReadPlan plan(set, max_gap);
+
+        std::size_t expected_ranges = 4;
+        std::size_t expected_gap    = 0;
+        if (max_gap >= 4) {
+            expected_ranges = 3;
+            expected_gap    = 4;
+        }
+        if (max_gap >= 100) {
+            expected_ranges = 1;
+            expected_gap    = 204 - 19;
+        }
+        assert(plan.ranges().size() == expected_ranges);
+        assert(plan.gap_bytes() == expected_gap);
+        assert(plan.buffer_size() == 19 + expected_gap);
+
+        // copy and format from the local buffer
+        std::vector<uint8_t> buffer(plan.buffer_size());
+        plan.copy(buffer.data());
+
+        const auto local = plan.bind(buffer.data());
+        assert(local.size() == set.size());
+        for (std::size_t i = 0; i < set.size(); ++i) {
+            assert(local[i].name == set[i].name);
+            assert(local[i].formatter->string() == set[i].formatter->string());
+        }
+
+        // the local formatters share the buffer as base address
+        assert(local.region().size <= plan.buffer_size());
+        assert(memformat::JsonArraySink(local).render() == memformat::JsonArraySink(set).render());
+    }
+
+    // empty set
+    const memformat::ReadPlan empty {memformat::FormatterSet()};
+    assert(empty.ranges().empty() && empty.buffer_size() == 0);
+}
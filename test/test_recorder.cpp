@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+#include "Recorder.hpp"
+#include "Replay.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+int main() {
+    char path[] = "/tmp/memformat_recording_XXXXXX";
+    int  fd     = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    alignas(8) uint8_t data[256] {};
+
+    memformat::FormatterSet set;
+    set.add("counter", data, "0x10", memformat::wordsize::BIT_32, memformat::format::UNSIGNED);
+    set.add("flag", data, "0x20.3", memformat::wordsize::BIT_1);
+    set.add("value", data, "0xF0", memformat::wordsize::BIT_64, memformat::format::FLOAT);
+
+    const auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1000));
+
+    constexpr std::size_t    FRAMES = 100;
+    std::vector<std::string> expected;
+
+    std::uint64_t recorded_size;
+    {
+        memformat::Recorder   recorder(path, set, 16, 512);
+        memformat::CsvRowSink csv(set);
+        std::vector<uint8_t>  copy(set.region().size);
+
+        for (std::size_t i = 0; i < FRAMES; ++i) {
+            *reinterpret_cast<uint32_t *>(data + 0x10) = static_cast<uint32_t>(i * 3);
+            data[0x20]                                 = static_cast<uint8_t>(i % 5 == 0 ? 0x08 : 0);
+            if (i % 10 == 0) *reinterpret_cast<double *>(data + 0xF0) = static_cast<double>(i) / 4;
+            if (i == 50) std::fill(data + 0x30, data + 0xE0, 0xAA);  // delta larger than the frame
+
+            const auto timestamp = start + std::chrono::milliseconds(10 * i);
+            if (i % 2) {
+                recorder.record(timestamp);
+            } else {
+                std::copy(data + 0x10, data + 0xF8, copy.begin());
+                recorder.record(copy.data(), timestamp);
+            }
+            expected.emplace_back(csv.render());
+        }
+
+        assert(recorder.frames() == FRAMES);
+        recorded_size = recorder.size();
+
+        // much smaller than the raw frames
+        assert(recorded_size < FRAMES * set.region().size / 2);
+    }
+
+    // replay
+    {
+        memformat::Replay     replay(path, set);
+        memformat::CsvRowSink csv(replay.formatters());
+        assert(replay.size() == FRAMES);
+
+        for (std::size_t i = 0; i < FRAMES; ++i) {
+            replay.load(i);
+            assert(csv.render() == expected[i]);
+            assert(replay.info(i).sequence == i);
+            assert(replay.info(i).timestamp == start + std::chrono::milliseconds(10 * i));
+        }
+
+        // random access
+        for (auto i : {99, 3, 4, 48, 51, 17, 17, 0, 63}) {
+            replay.load(static_cast<std::size_t>(i));
+            assert(csv.render() == expected[static_cast<std::size_t>(i)]);
+        }
+
+        assert(replay.find(start) == 0);
+        assert(replay.find(start + std::chrono::milliseconds(15)) == 1);
+        assert(replay.find(start + std::chrono::hours(1)) == FRAMES - 1);
+
+        bool thrown = false;
+        try {
+            static_cast<void>(replay.find(start - std::chrono::milliseconds(1)));
+        } catch (const std::out_of_range &) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            replay.load(FRAMES);
+        } catch (const std::out_of_range &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // set that does not match the recording
+    {
+        memformat::FormatterSet other;
+        other.add("counter", data, "0x10", memformat::wordsize::BIT_32, memformat::format::UNSIGNED);
+
+        bool thrown = false;
+        try {
+            memformat::Replay replay(path, other);
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // truncated last frame is ignored
+    {
+        assert(truncate(path, static_cast<off_t>(recorded_size - 1)) == 0);
+        memformat::Replay     replay(path, set);
+        memformat::CsvRowSink csv(replay.formatters());
+        assert(replay.size() == FRAMES - 1);
+        replay.load(FRAMES - 2);
+        assert(csv.render() == expected[FRAMES - 2]);
+    }
+
+    // not a recording
+    {
+        assert(truncate(path, 4) == 0);
+        bool thrown = false;
+        try {
+            memformat::Replay replay(path, set);
+        } catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    unlink(path);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+#include "OutputSink.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::wordsize;
+
+    // per call base address
+    {
+        alignas(8) uint8_t front[16] {};
+        alignas(8) uint8_t back[16] {};
+
+        const uint32_t a = 0x12345678;
+        const uint32_t b = 0xCAFEBABE;
+        std::memcpy(front + 4, &a, sizeof(a));
+        std::memcpy(back + 4, &b, sizeof(b));
+        back[9] = 0x04;
+
+        for (const auto f : {format::BIN, format::OCT, format::HEX, format::SIGNED, format::UNSIGNED, format::FLOAT}) {
+            for (const auto e : {endianness::HOST, endianness::BIG, endianness::LITTLE}) {
+                const auto formatter = memformat::MemoryFormatter::get_formatter(front, 4, wordsize::BIT_32, f, e);
+                const auto other     = memformat::MemoryFormatter::get_formatter(back, 4, wordsize::BIT_32, f, e);
+
+                assert(formatter->result(back) == other->string());
+                assert(formatter->result() == formatter->string());
+
+                std::string out;
+                formatter->append_to(back, out);
+                assert(out == other->string());
+            }
+        }
+
+        const auto bit =
+                memformat::MemoryFormatter::get_formatter(front, 9, wordsize::BIT_1, format::BIN, endianness::HOST, 2);
+        assert(bit->result() == "0");
+        assert(bit->result(back) == "1");
+    }
+
+    // double buffer: the sink is rebound without reconstructing the formatters
+    // (the bound address replaces the base address of the formatters)
+    {
+        alignas(8) uint8_t buffers[2][8] {};
+        for (uint8_t i = 0; i < 8; ++i) {
+            buffers[0][i] = i;
+            buffers[1][i] = static_cast<uint8_t>(0x10 + i);
+        }
+
+        memformat::FormatterSet set;
+        set.add("a", memformat::MemoryFormatter::get_formatter(buffers[0], 2, wordsize::BIT_8, format::UNSIGNED));
+        set.add("b", memformat::MemoryFormatter::get_formatter(buffers[0], 5, wordsize::BIT_8, format::HEX));
+
+        memformat::JsonObjectSink json(set);
+        memformat::CsvRowSink     csv(set);
+        assert(json.bound() == nullptr);
+        assert(json.render() == R"({"a":2,"b":"5"})");
+
+        json.bind(buffers[1]);
+        csv.bind(buffers[1]);
+        assert(json.render() == R"({"a":18,"b":"15"})");
+        assert(csv.render() == "18,15\n");
+
+        assert(json.render_region(buffers[0]) == R"({"a":2,"b":"5"})");
+
+        json.bind(nullptr);
+        assert(json.render() == R"({"a":2,"b":"5"})");
+
+        memformat::LineProtocolSink lp(set, "m");
+        lp.bind(buffers[1]);
+        assert(lp.render(7) == "m a=18u,b=\"15\" 7\n");
+    }
+
+    // N identical device images
+    {
+        constexpr std::size_t IMAGES     = 4;
+        constexpr std::size_t IMAGE_SIZE = 16;
+
+        alignas(8) uint8_t images[IMAGES][IMAGE_SIZE] {};
+        for (std::size_t i = 0; i < IMAGES; ++i) {
+            const auto value = static_cast<uint16_t>(1000 * i);
+            std::memcpy(images[i] + 8, &value, sizeof(value));
+        }
+
+        memformat::FormatterSet set;
+        set.add("v", memformat::MemoryFormatter::get_formatter(images[0], 8, wordsize::BIT_16, format::UNSIGNED));
+
+        memformat::JsonArraySink sink(set);
+        std::string              out;
+        for (std::size_t i = 0; i < IMAGES; ++i)
+            sink.render_region_to(out, images[i]);
+        assert(out == "[0][1000][2000][3000]");
+    }
+
+    // a memory region requires a single base address
+    {
+        uint8_t front[8] {};
+        uint8_t back[8] {};
+
+        memformat::FormatterSet set;
+        set.add("a", memformat::MemoryFormatter::get_formatter(front, 0, wordsize::BIT_8, format::UNSIGNED));
+        set.add("b", memformat::MemoryFormatter::get_formatter(back, 4, wordsize::BIT_8, format::UNSIGNED));
+
+        bool thrown = false;
+        try {
+            (void) set.region();
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            memformat::JsonObjectSink json(set);
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+}
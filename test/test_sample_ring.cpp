@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+#include "SampleRing.hpp"
+#include "Sampler.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <string>
+#include <thread>
+
+int main() {
+    alignas(8) uint8_t data[16] {};
+
+    memformat::FormatterSet set;
+    set.add("a", data, "4", memformat::wordsize::BIT_8, memformat::format::UNSIGNED);
+    set.add("b", data, "6", memformat::wordsize::BIT_16, memformat::format::HEX);
+
+    // single thread: capture, drop if full and consume in order
+    {
+        memformat::SampleRing ring(set, 3);
+        assert(ring.get_region().size == 4);
+        [[maybe_unused]] const auto *empty = ring.front();
+        assert(empty == nullptr);
+
+        for (uint8_t i = 0; i < 5; ++i) {
+            data[4] = i;
+            [[maybe_unused]] const bool captured = ring.capture();
+            assert(captured == (i < 3));
+        }
+        assert(ring.size() == 3);
+        assert(ring.dropped_samples() == 2);
+
+        memformat::JsonArraySink sink(ring.sample_set());
+
+        const auto *sample = ring.front();
+        assert(sample);
+        assert(sample->sequence == 0);
+        [[maybe_unused]] const auto &first = sink.render_region(sample->base());
+        assert(first == "[0,\"0\"]");
+        ring.pop();
+
+        std::string output;
+
+        [[maybe_unused]] const auto consumed = ring.consume([&](const memformat::SampleRing::Sample &s) {
+            output += sink.render_region(s.base());
+        });
+        assert(consumed == 2);
+        assert(output == "[1,\"0\"][2,\"0\"]");
+        assert(ring.size() == 0);
+
+        // gap in the sequence numbers after dropped samples
+        [[maybe_unused]] const bool captured = ring.capture();
+        assert(captured);
+        [[maybe_unused]] const auto *next = ring.front();
+        assert(next && next->sequence == 5);
+        ring.pop();
+    }
+
+    // producer and consumer thread
+    {
+        memformat::SampleRing ring(set, 64);
+        constexpr uint16_t    N = 20000;
+
+        std::thread producer([&]() {
+            for (uint16_t i = 0; i < N; ++i) {
+                auto *value = reinterpret_cast<uint16_t *>(data + 6);
+                *value      = i;
+                while (!ring.capture()) std::this_thread::yield();
+            }
+        });
+
+        uint16_t expected = 0;
+        while (expected < N) {
+            ring.consume([&](const memformat::SampleRing::Sample &s) {
+                const auto reference = memformat::MemoryFormatter::get_formatter(
+                        const_cast<void *>(s.data), "2", memformat::wordsize::BIT_16, memformat::format::HEX);
+                assert(ring.sample_set()[1].formatter->result(s.base()) == reference->string());
+                assert(*reinterpret_cast<const uint16_t *>(static_cast<const uint8_t *>(s.data) + 2) == expected);
+                ++expected;
+            });
+        }
+        producer.join();
+    }
+
+    // sampler captures into the ring
+    {
+        memformat::SampleRing ring(set, 1024);
+        data[4] = 42;
+
+        memformat::Sampler sampler(ring, std::chrono::milliseconds(1));
+        sampler.start();
+        while (ring.size() < 5)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sampler.stop();
+
+        assert(sampler.snapshot_set().empty());
+        const auto consumed = ring.consume([&](const memformat::SampleRing::Sample &s) {
+            assert(static_cast<const uint8_t *>(s.data)[0] == 42);
+        });
+        assert(consumed >= 5);
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+#include "Sampler.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifdef OS_LINUX
+#    include <sched.h>
+#endif
+
+int main() {
+    alignas(8) uint8_t data[64] {};
+    data[16] = 1;
+    data[17] = 2;
+    data[20] = 0b100;
+
+    memformat::FormatterSet set;
+    set.add("a", data, "16", memformat::wordsize::BIT_8, memformat::format::UNSIGNED);
+    set.add("b", data, "17", memformat::wordsize::BIT_8, memformat::format::UNSIGNED);
+    set.add("c", data, "20.2", memformat::wordsize::BIT_1);
+
+    const auto region = set.region();
+    assert(region.address == data + 16);
+    assert(region.size == 5);
+
+    // rebind to a copy of the memory region
+    uint8_t copy[5] {7, 8, 0, 0, 0};
+    auto    rebound = set.rebind(copy);
+    assert(rebound.size() == 3);
+    assert(rebound[0].name == "a");
+    assert(rebound[0].formatter->string() == "7");
+    assert(rebound[1].formatter->string() == "8");
+    assert(rebound[2].formatter->string() == "0");
+
+    // sampler
+    std::vector<std::string>                  lines;
+    std::unique_ptr<memformat::JsonArraySink> sink;
+    std::uint64_t                             expected_sequence = 0;
+
+    memformat::Sampler sampler(set, std::chrono::milliseconds(2), [&](const memformat::Sampler::Frame &frame) {
+        assert(frame.sequence == expected_sequence++);
+        assert(frame.size == 5);
+        assert(static_cast<const uint8_t *>(frame.data)[0] == 1);
+        lines.emplace_back(sink->render());
+    });
+    sink = std::make_unique<memformat::JsonArraySink>(sampler.snapshot_set());
+
+    sampler.start();
+    assert(sampler.is_running());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.stop();
+    assert(!sampler.is_running());
+
+    const auto statistics = sampler.statistics();
+    assert(statistics.cycles > 0);
+    assert(statistics.cycles == lines.size());
+    assert(statistics.latency_max >= statistics.latency_mean);
+    assert(statistics.duration_max >= statistics.duration_mean);
+    for (const auto &line : lines)
+        assert(line == "[1,2,1]");
+
+    // exceptions of the callback stop the sampler and are rethrown by stop()
+    memformat::Sampler failing(set, std::chrono::milliseconds(1), [](const memformat::Sampler::Frame &) {
+        throw std::runtime_error("callback failed");
+    });
+    failing.start();
+    while (failing.is_running())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    bool thrown = false;
+    try {
+        failing.stop();
+    } catch (const std::runtime_error &) { thrown = true; }
+    assert(thrown);
+
+#ifdef OS_LINUX
+    // the thread is pinned before the first cycle (to the first cpu that this process may use)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    [[maybe_unused]] const bool affinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    assert(affinity);
+    int target = 0;
+    while (!CPU_ISSET(target, &allowed))
+        ++target;
+
+    int                cpu = -1;
+    memformat::Sampler pinned(
+            set,
+            std::chrono::milliseconds(1),
+            [&](const memformat::Sampler::Frame &frame) {
+                if (frame.sequence == 0) cpu = sched_getcpu();
+            },
+            target);
+    pinned.start();
+    while (pinned.statistics().cycles == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pinned.stop();
+    assert(cpu == target);
+
+    // no cycle is executed if pinning fails
+    bool               called = false;
+    memformat::Sampler unpinnable(
+            set,
+            std::chrono::milliseconds(1),
+            [&](const memformat::Sampler::Frame &) { called = true; },
+            CPU_SETSIZE - 1);
+    thrown = false;
+    try {
+        unpinnable.start();
+    } catch (const std::system_error &) { thrown = true; }
+    assert(thrown);
+    assert(!called);
+    assert(!unpinnable.is_running());
+#endif
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "endian.hpp"
+#include "Scanner.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+int main() {
+    // pseudo random memory image
+    std::vector<uint8_t> data(1 << 20);
+    uint32_t             state = 12345;
+    for (auto &byte : data) {
+        state = state * 1103515245 + 12345;
+        byte  = static_cast<uint8_t>(state >> 16);
+    }
+
+    // 42.0f, word swapped big endian
+    {
+        const float value = 42.0f;
+        uint32_t    raw;
+        std::memcpy(&raw, &value, sizeof(raw));
+        raw = ::endian::host_to_big(raw);
+        uint16_t words[2];
+        std::memcpy(words, &raw, sizeof(raw));
+        std::swap(words[0], words[1]);
+
+        const std::vector<std::size_t> planted {3, 17, 4096, 4097 + 64, 777777, data.size() - 4};
+        for (const auto offset : planted)
+            std::memcpy(data.data() + offset, words, sizeof(words));
+
+        const auto result = memformat::scan_float(
+                data.data(), data.size(), memformat::wordsize::BIT_32, memformat::endianness::BIG_SWAP16, 42.0);
+        assert(result == planted);
+
+        for (const auto offset : result) {
+            auto formatter = memformat::MemoryFormatter::get_formatter(data.data(),
+                                                                       offset,
+                                                                       memformat::wordsize::BIT_32,
+                                                                       memformat::format::FLOAT,
+                                                                       memformat::endianness::BIG_SWAP16);
+            assert(formatter->string() == "42.000000");
+        }
+
+        // aligned offsets only
+        memformat::ScanOptions options;
+        options.alignment = 4;
+        const auto aligned = memformat::scan_float(data.data(),
+                                                   data.size(),
+                                                   memformat::wordsize::BIT_32,
+                                                   memformat::endianness::BIG_SWAP16,
+                                                   42.0,
+                                                   options);
+        for (const auto offset : aligned)
+            assert(offset % 4 == 0);
+        assert(std::count_if(planted.begin(), planted.end(), [](std::size_t o) { return o % 4 == 0; }) ==
+               static_cast<std::ptrdiff_t>(aligned.size()));
+
+        options             = {};
+        options.max_results = 2;
+        const auto limited  = memformat::scan_float(data.data(),
+                                                   data.size(),
+                                                   memformat::wordsize::BIT_32,
+                                                   memformat::endianness::BIG_SWAP16,
+                                                   42.0,
+                                                   options);
+        assert(limited == std::vector<std::size_t>({3, 17}));
+    }
+
+    // compare with a simple reference implementation
+    {
+        const uint16_t value  = 0xBEEF;
+        const auto     result = memformat::scan_unsigned(
+                data.data(), data.size(), memformat::wordsize::BIT_16, memformat::endianness::LITTLE, value);
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i + 1 < data.size(); ++i) {
+            if (data[i] == 0xEF && data[i + 1] == 0xBE) expected.push_back(i);
+        }
+        assert(!expected.empty());
+        assert(result == expected);
+
+        const auto signed_result = memformat::scan_signed(data.data(),
+                                                          data.size(),
+                                                          memformat::wordsize::BIT_16,
+                                                          memformat::endianness::LITTLE,
+                                                          static_cast<int16_t>(value));
+        assert(signed_result == expected);
+    }
+
+    // range
+    {
+        std::vector<uint8_t> small(64, 0xFF);
+        const uint32_t       counter = ::endian::host_to_big(uint32_t {1500});
+        std::memcpy(small.data() + 9, &counter, sizeof(counter));
+
+        const auto result = memformat::scan_range(small.data(),
+                                                  small.size(),
+                                                  memformat::wordsize::BIT_32,
+                                                  memformat::endianness::BIG,
+                                                  memformat::format::UNSIGNED,
+                                                  1000,
+                                                  2000);
+        assert(result == std::vector<std::size_t>({9}));
+
+        const auto negative = memformat::scan_range(small.data(),
+                                                    small.size(),
+                                                    memformat::wordsize::BIT_8,
+                                                    memformat::endianness::HOST,
+                                                    memformat::format::SIGNED,
+                                                    -1,
+                                                    -1);
+        assert(negative.size() == 60);
+    }
+
+    // invalid arguments
+    {
+        bool thrown = false;
+        try {
+            static_cast<void>(memformat::scan_unsigned(
+                    data.data(), data.size(), memformat::wordsize::BIT_8, memformat::endianness::HOST, 256));
+        } catch (const std::out_of_range &) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            static_cast<void>(memformat::scan_unsigned(
+                    data.data(), data.size(), memformat::wordsize::BIT_16, memformat::endianness::BIG_SWAP16, 1));
+        } catch (const std::invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "StaticLayout.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+using memformat::endianness;
+using memformat::format;
+using memformat::StaticField;
+using memformat::StaticLayout;
+using memformat::wordsize;
+
+using Layout = StaticLayout<StaticField<0, wordsize::BIT_8, format::SIGNED>,
+                            StaticField<1, wordsize::BIT_1, format::BIN, endianness::HOST, 5>,
+                            StaticField<2, wordsize::BIT_16, format::HEX, endianness::BIG>,
+                            StaticField<4, wordsize::BIT_32, format::FLOAT, endianness::LITTLE_SWAP16>,
+                            StaticField<8, wordsize::BIT_64, format::UNSIGNED, endianness::BIG_SWAP32>,
+                            StaticField<8, wordsize::BIT_64, format::BIN, endianness::LITTLE>>;
+
+static_assert(Layout::size == 6);
+static_assert(Layout::required_size == 16);
+static_assert(Layout::field<1>::bit_index == 5);
+static_assert(Layout::field<0>::endian == endianness::HOST);
+static_assert(Layout::field<3>::max_offset == 7);
+
+struct Image {
+    uint8_t data[16];
+};
+
+/**
+ * @brief compare the output of a static field with the corresponding dynamic formatter
+ * @tparam Field StaticField type
+ * @param data memory
+ */
+template <typename Field>
+static void check_field(uint8_t *data) {
+    const auto formatter = memformat::MemoryFormatter::get_formatter(
+            data, Field::offset, Field::word_size, Field::output_format, Field::endian, Field::bit_index);
+
+    char       buffer[memformat::MAX_STRING_LENGTH];
+    const auto end = Field::format_to(data, buffer);
+    assert(std::string(buffer, end) == formatter->string());
+}
+
+/**
+ * @brief check all formats of a word size and endianness
+ * @tparam W word size
+ * @tparam E endianness
+ * @param data memory
+ */
+template <wordsize W, endianness E>
+static void check_formats(uint8_t *data) {
+    check_field<StaticField<1, W, format::BIN, E>>(data);
+    check_field<StaticField<1, W, format::OCT, E>>(data);
+    check_field<StaticField<1, W, format::HEX, E>>(data);
+    check_field<StaticField<1, W, format::SIGNED, E>>(data);
+    check_field<StaticField<1, W, format::UNSIGNED, E>>(data);
+    if constexpr (W == wordsize::BIT_32 || W == wordsize::BIT_64) {
+        check_field<StaticField<1, W, format::FLOAT, E>>(data);
+    }
+}
+
+/**
+ * @brief check all bit indices
+ * @param data memory
+ */
+template <std::size_t... Bits>
+static void check_bits(uint8_t *data, std::index_sequence<Bits...>) {
+    (check_field<StaticField<1, wordsize::BIT_1, format::BIN, endianness::HOST, Bits>>(data), ...);
+}
+
+int main() {
+    const uint64_t patterns[] = {0, 0xFFFFFFFFFFFFFFFF, 0x0123456789ABCDEF, 0xC5B4A3F2E1D0C0B0, 0x3FF0000000000000};
+
+    for (const auto pattern : patterns) {
+        uint8_t data[16] {};
+        std::memcpy(data + 1, &pattern, sizeof(pattern));
+
+        check_formats<wordsize::BIT_8, endianness::HOST>(data);
+        check_formats<wordsize::BIT_16, endianness::HOST>(data);
+        check_formats<wordsize::BIT_16, endianness::BIG>(data);
+        check_formats<wordsize::BIT_16, endianness::LITTLE>(data);
+        check_formats<wordsize::BIT_32, endianness::HOST>(data);
+        check_formats<wordsize::BIT_32, endianness::BIG>(data);
+        check_formats<wordsize::BIT_32, endianness::LITTLE>(data);
+        check_formats<wordsize::BIT_32, endianness::BIG_SWAP16>(data);
+        check_formats<wordsize::BIT_32, endianness::LITTLE_SWAP16>(data);
+        check_formats<wordsize::BIT_64, endianness::HOST>(data);
+        check_formats<wordsize::BIT_64, endianness::BIG>(data);
+        check_formats<wordsize::BIT_64, endianness::LITTLE>(data);
+        check_formats<wordsize::BIT_64, endianness::BIG_SWAP16>(data);
+        check_formats<wordsize::BIT_64, endianness::LITTLE_SWAP16>(data);
+        check_formats<wordsize::BIT_64, endianness::BIG_SWAP32>(data);
+        check_formats<wordsize::BIT_64, endianness::LITTLE_SWAP32>(data);
+
+        check_bits(data, std::make_index_sequence<8>());
+    }
+
+    // complete layout
+    Image image {};
+    for (uint8_t i = 0; i < sizeof(image.data); ++i)
+        image.data[i] = static_cast<uint8_t>(0x11 * i + 0x80);
+
+    std::vector<std::string> values;
+    Layout::for_each_in(image, [&](std::size_t index, std::string_view value) {
+        assert(index == values.size());
+        values.emplace_back(value);
+    });
+    assert(values.size() == Layout::size);
+    assert(values[0] == "-128");
+    assert(values[1] == "0");
+    assert(values[2] == "a2b3");
+
+    std::size_t count = 0;
+    Layout::for_each(image.data, [&](std::size_t index, std::string_view value) {
+        assert(value == values[index]);
+        ++count;
+    });
+    assert(count == Layout::size);
+}
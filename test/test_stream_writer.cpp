@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "OutputSink.hpp"
+#include "StreamWriter.hpp"
+
+#include <cassert>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+/**
+ * @brief read all available data from a non blocking file descriptor
+ */
+static std::string read_all(int fd) {
+    std::string result;
+    char        buffer[4096];
+    ssize_t     n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+        result.append(buffer, static_cast<std::size_t>(n));
+    return result;
+}
+
+int main() {
+    int fds[2];
+
+    [[maybe_unused]] const bool created = pipe(fds) == 0 && fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0 &&
+                                          fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0;
+    assert(created);
+
+    alignas(8) uint8_t data[8] {0x12, 0x34};
+
+    memformat::FormatterSet set;
+    set.add("a", data, "0", memformat::wordsize::BIT_8, memformat::format::HEX);
+    set.add("b", data, "1", memformat::wordsize::BIT_8, memformat::format::UNSIGNED);
+    memformat::CsvRowSink csv(set);
+
+    {
+        memformat::StreamWriter writer(fds[1]);
+
+        // multiple lines are written with a single flush
+        bool accepted = true;
+        for (int i = 0; i < 3; ++i)
+            accepted = writer.write(csv.render()) && accepted;
+        accepted = writer.write(*set[0].formatter) && accepted;
+        accepted = writer.write("\n") && accepted;
+        assert(accepted);
+        assert(writer.pending_bytes() == 3 * 6 + 3);
+
+        while (writer.pending_bytes())
+            writer.flush();
+        assert(writer.bytes_written() == 3 * 6 + 3);
+        const auto lines = read_all(fds[0]);
+        assert(lines == "12,52\n12,52\n12,52\n12\n");
+
+        // data written after the flush
+        accepted = writer.write("abc");
+        assert(accepted);
+    }
+
+    // remaining data is flushed by the destructor
+    const auto remaining = read_all(fds[0]);
+    assert(remaining == "abc");
+
+    // back-pressure: the buffer limit is reached if the pipe is not read
+    {
+        const auto              page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        memformat::StreamWriter writer(fds[1], 1, 2);
+        const std::string       chunk(page_size / 2, 'x');
+
+        bool accepted = true;
+        for (int i = 0; i < 4; ++i)
+            accepted = writer.write(chunk) && accepted;
+        assert(accepted);
+        [[maybe_unused]] const bool rejected = !writer.write("y") && !writer.write(*set[0].formatter);
+        assert(rejected);
+        assert(writer.pending_bytes() == 2 * page_size);
+
+        // buffers are reused after the data was written
+        while (writer.pending_bytes())
+            writer.flush();
+        accepted = writer.write(chunk);
+        assert(accepted);
+        while (writer.pending_bytes())
+            writer.flush();
+
+        const auto received = read_all(fds[0]);
+        assert(received == std::string(5 * (page_size / 2), 'x'));
+    }
+
+    // a full pipe does not block the writer
+    {
+        memformat::StreamWriter writer(fds[1], 65536, 64);
+        const std::string       chunk(65536, 'z');
+        bool accepted = true;
+        for (int i = 0; i < 16; ++i)
+            accepted = writer.write(chunk) && accepted;
+        assert(accepted);
+
+        writer.flush();
+        writer.flush();
+        assert(writer.pending_bytes() > 0);
+
+        std::size_t received = 0;
+        while (writer.pending_bytes()) {
+            writer.flush();
+            received += read_all(fds[0]).size();
+        }
+        received += read_all(fds[0]).size();
+        assert(received == 16 * 65536);
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
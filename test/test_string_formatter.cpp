@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "BatchDecoder.hpp"
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+#include "OutputSink.hpp"
+#include "ReadPlan.hpp"
+#include "StringFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief check whether a function throws std::invalid_argument
+ * @param f function
+ * @return true if the function throws
+ */
+template <typename F>
+static bool throws(F f) {
+    try {
+        f();
+    } catch (const std::invalid_argument &) { return true; }
+    return false;
+}
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::string_termination;
+    using memformat::wordsize;
+
+    // byte order (a field with more than one shuffle block)
+    char       data[64] = "BADCFEHGJILKNMPORQTSVUXWZY";
+    const auto swapped  = memformat::get_string_formatter(data, 0, 26, wordsize::BIT_16, endianness::LITTLE);
+    assert(swapped->string() == "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    assert(swapped->max_offset() == 25);
+    assert(swapped->get_format() == format::STRING);
+    assert(swapped->get_wordsize() == wordsize::BIT_16);
+
+    const auto plain = memformat::get_string_formatter(data, 0, 4);
+    assert(plain->string() == "BADC");
+    assert(memformat::get_string_formatter(data, 0, 4, wordsize::BIT_16, endianness::BIG)->string() == "BADC");
+
+    std::memcpy(data, "DCBAHGFE", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_32, endianness::LITTLE)->string() == "ABCDEFGH");
+    std::memcpy(data, "CDABGHEF", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_32, endianness::BIG_SWAP16)->string() ==
+           "ABCDEFGH");
+    std::memcpy(data, "BADCFEHG", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_32, endianness::LITTLE_SWAP16)->string() ==
+           "ABCDEFGH");
+    std::memcpy(data, "EFGHABCD", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_64, endianness::BIG_SWAP32)->string() ==
+           "ABCDEFGH");
+    std::memcpy(data, "DCBAHGFE", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_64, endianness::LITTLE_SWAP32)->string() ==
+           "ABCDEFGH");
+    std::memcpy(data, "HGFEDCBA", 8);
+    assert(memformat::get_string_formatter(data, 0, 8, wordsize::BIT_64, endianness::LITTLE)->string() ==
+           "ABCDEFGH");
+
+    // termination
+    std::memcpy(data, "eDivec\0\0\0\0", 10);
+    const auto name = memformat::get_string_formatter(data, 0, 10, wordsize::BIT_16, endianness::LITTLE);
+    assert(name->string() == "Device");
+    std::memcpy(data, "SN  ", 4);
+    assert(memformat::get_string_formatter(data, 0, 4, wordsize::BIT_8, endianness::HOST, string_termination::TRIM)
+                   ->string() == "SN");
+    assert(memformat::get_string_formatter(data, 0, 4, wordsize::BIT_8, endianness::HOST, string_termination::NUL)
+                   ->string() == "SN  ");
+
+    // escaping
+    std::memcpy(data, "A\0B\\\x7f\n", 6);
+    const auto all =
+            memformat::get_string_formatter(data, 0, 6, wordsize::BIT_8, endianness::HOST, string_termination::NONE);
+    assert(all->string() == "A\\x00B\\\\\\x7f\\x0a");
+    const auto replaced = memformat::get_string_formatter(
+            data, 0, 6, wordsize::BIT_8, endianness::HOST, string_termination::NONE, false);
+    assert(replaced->string() == "A.B\\..");
+
+    // the longest output fits into the output buffer
+    char long_field[317];
+    std::memset(long_field, 0x01, sizeof(long_field));
+    const auto escaped = memformat::get_string_formatter(long_field, 0, 78, wordsize::BIT_16, endianness::LITTLE);
+    assert(escaped->string().size() == 78 * 4);
+    const auto unescaped = memformat::get_string_formatter(
+            long_field, 0, 316, wordsize::BIT_32, endianness::LITTLE, string_termination::NONE, false);
+    assert(unescaped->string() == std::string(316, '.'));
+
+    // invalid arguments
+    assert(throws([&] { (void) memformat::get_string_formatter(data, 0, 0); }));
+    assert(throws([&] { (void) memformat::get_string_formatter(data, 0, 3, wordsize::BIT_16); }));
+    assert(throws([&] { (void) memformat::get_string_formatter(data, 0, 4, wordsize::BIT_1); }));
+    assert(throws([&] { (void) memformat::get_string_formatter(data, 0, 80); }));
+    assert(throws(
+            [&] { (void) memformat::get_string_formatter(data, 0, 4, wordsize::BIT_16, endianness::BIG_SWAP16); }));
+
+    // memory access semantics
+    std::memcpy(data, "eDivec\0\0\0\0", 10);
+    for (const auto access : {memformat::memory_access::VOLATILE,
+                              memformat::memory_access::PLAIN,
+                              memformat::memory_access::RELAXED,
+                              memformat::memory_access::ACQUIRE}) {
+        assert(name->result(data, access) == "Device");
+    }
+
+    // relocation
+    memformat::FormatterSet set;
+    set.add("name", name);
+    set.add("swapped", memformat::get_string_formatter(data, 16, 4, wordsize::BIT_16, endianness::LITTLE));
+    std::memcpy(data + 16, "BADC", 4);
+
+    char copy[20];
+    std::memcpy(copy, data, sizeof(copy));
+    std::memset(data, 0, sizeof(copy));
+    const auto rebound = set.rebind(copy);
+    assert(rebound[0].formatter->string() == "Device");
+    assert(rebound[1].formatter->string() == "ABCD");
+
+    std::memcpy(data, copy, sizeof(copy));
+    const memformat::ReadPlan plan(set);
+    char                      buffer[20];
+    plan.copy(buffer);
+    const auto bound = plan.bind(buffer);
+    assert(bound[0].formatter->string() == "Device");
+    assert(bound[1].formatter->string() == "ABCD");
+
+    // sinks write character fields as strings
+    std::memcpy(data, "a\"b\\c\0\0\0\0", 10);
+    memformat::FormatterSet fields;
+    fields.add("name", memformat::get_string_formatter(data, 0, 10, wordsize::BIT_8, endianness::HOST));
+    fields.add("value", memformat::MemoryFormatter::get_formatter(data, "12", wordsize::BIT_8, format::UNSIGNED));
+    data[12] = 7;
+    assert(memformat::JsonObjectSink(fields).render() == R"({"name":"a\"b\\\\c","value":7})");
+    assert(memformat::CsvRowSink(fields).render() == "\"a\"\"b\\\\c\",7\n");
+    assert(memformat::LineProtocolSink(fields, "m").render() == R"(m name="a\"b\\\\c",value=7u)" "\n");
+
+    // character fields are not numeric columns
+    assert(throws([&] { memformat::BatchDecoder decoder(fields); }));
+}
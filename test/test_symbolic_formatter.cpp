@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2023 Nikolas Koesling <nikolas@koesling.info>.
+ * This program is free software. You can redistribute it and/or modify it under the terms of the MIT License.
+ */
+
+#include "FormatterSet.hpp"
+#include "MemoryFormatter.hpp"
+#include "OutputSink.hpp"
+#include "ReadPlan.hpp"
+#include "SymbolicFormatter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief check whether a function throws std::invalid_argument
+ * @param f function
+ * @return true if the function throws
+ */
+template <typename F>
+static bool throws(F f) {
+    try {
+        f();
+    } catch (const std::invalid_argument &) { return true; }
+    return false;
+}
+
+int main() {
+    using memformat::endianness;
+    using memformat::format;
+    using memformat::LabelTable;
+    using memformat::wordsize;
+
+    // dense table
+    const auto states = std::make_shared<const LabelTable>(
+            LabelTable::Entries {{0, "STOPPED"}, {1, "RUNNING"}, {2, "FAULT"}, {10, "MAINTENANCE"}});
+    assert(states->is_dense());
+    assert(states->size() == 4);
+    assert(states->max_label_length() == 11);
+    assert(states->find(1) == "RUNNING");
+    assert(states->find(10) == "MAINTENANCE");
+    assert(states->find(5).empty());
+    assert(states->find(11).empty());
+    assert(states->find(~std::uint64_t {0}).empty());
+
+    // sparse table
+    LabelTable::Entries sparse_entries;
+    for (std::uint64_t i = 0; i < 100; ++i)
+        sparse_entries.emplace_back(i * 0x100000001ULL, "V" + std::to_string(i));
+    const LabelTable sparse(sparse_entries);
+    assert(!sparse.is_dense());
+    for (std::uint64_t i = 0; i < 100; ++i)
+        assert(sparse.find(i * 0x100000001ULL) == "V" + std::to_string(i));
+    assert(sparse.find(1).empty());
+    assert(sparse.find(0x100000000ULL).empty());
+
+    std::size_t visited = 0;
+    sparse.for_each([&](std::uint64_t value, std::string_view label) {
+        assert(label == "V" + std::to_string(value / 0x100000001ULL));
+        ++visited;
+    });
+    assert(visited == 100);
+
+    assert(throws([] { LabelTable table({{1, "A"}, {1, "B"}}); }));
+    assert(throws([] { LabelTable table({{1, ""}}); }));
+
+    // enum formatter
+    alignas(8) uint8_t data[16] {};
+    const uint16_t     state = 2;
+    std::memcpy(data, &state, sizeof(state));
+
+    const auto enum_formatter = memformat::get_enum_formatter(data, 0, wordsize::BIT_16, endianness::HOST, states);
+    assert(enum_formatter->string() == "FAULT");
+    assert(enum_formatter->result() == "FAULT");
+    assert(enum_formatter->raw() == 2);
+    assert(enum_formatter->get_format() == format::LABEL);
+
+    data[0] = 7;
+    assert(enum_formatter->string() == "7");
+
+    // big endian 32 bit value
+    data[4] = 0;
+    data[5] = 0;
+    data[6] = 0;
+    data[7] = 10;
+    assert(memformat::get_enum_formatter(data, 4, wordsize::BIT_32, endianness::BIG, states)->string() ==
+           "MAINTENANCE");
+
+    // bitmask formatter
+    const auto flags = std::make_shared<const LabelTable>(
+            LabelTable::Entries {{0x01, "FAULT"}, {0x04, "OVERTEMP"}, {0x80, "ESTOP"}});
+    const auto bitmask = memformat::get_bitmask_formatter(data, 8, wordsize::BIT_8, endianness::HOST, flags);
+
+    data[8] = 0;
+    assert(bitmask->string() == "0");
+    data[8] = 0x05;
+    assert(bitmask->string() == "FAULT|OVERTEMP");
+    data[8] = 0x80;
+    assert(bitmask->string() == "ESTOP");
+    data[8] = 0x87;
+    assert(bitmask->string() == "FAULT|OVERTEMP|ESTOP|0x2");
+    data[8] = 0x02;
+    assert(bitmask->string() == "0x2");
+
+    const auto spaced = memformat::get_bitmask_formatter(data, 8, wordsize::BIT_8, endianness::HOST, flags, ", ");
+    data[8]           = 0x85;
+    assert(spaced->string() == "FAULT, OVERTEMP, ESTOP");
+
+    const auto multi_bit   = std::make_shared<const LabelTable>(LabelTable::Entries {{3, "A"}});
+    const auto outside_bit = std::make_shared<const LabelTable>(LabelTable::Entries {{0x100, "A"}});
+    assert(throws([&] {
+        (void) memformat::get_bitmask_formatter(data, 8, wordsize::BIT_8, endianness::HOST, multi_bit);
+    }));
+    assert(throws([&] {
+        (void) memformat::get_bitmask_formatter(data, 8, wordsize::BIT_8, endianness::HOST, outside_bit);
+    }));
+    assert(throws([&] { (void) memformat::get_enum_formatter(data, 0, wordsize::BIT_1, endianness::HOST, states); }));
+    assert(throws([&] { (void) memformat::get_enum_formatter(data, 0, wordsize::BIT_8, endianness::HOST, nullptr); }));
+
+    // labels are kept by snapshot sets
+    memformat::FormatterSet set;
+    set.add("state", enum_formatter);
+    set.add("flags", bitmask);
+    data[0] = 1;
+    data[8] = 0x04;
+
+    uint8_t copy[16];
+    std::memcpy(copy, data, sizeof(copy));
+    const auto rebound = set.rebind(copy);
+    assert(rebound[0].formatter->string() == "RUNNING");
+    assert(rebound[1].formatter->string() == "OVERTEMP");
+
+    const memformat::ReadPlan plan(set);
+    uint8_t                   buffer[16];
+    plan.copy(buffer);
+    const auto bound = plan.bind(buffer);
+    assert(bound[0].formatter->string() == "RUNNING");
+    assert(bound[1].formatter->string() == "OVERTEMP");
+
+    // sinks write labels as strings
+    const auto quoted = std::make_shared<const LabelTable>(LabelTable::Entries {{0x01, "A\"B"}, {0x02, "C\\D"}});
+    set.add("text", memformat::get_bitmask_formatter(data, 9, wordsize::BIT_8, endianness::HOST, quoted, ","));
+    data[8] = 0x05;
+    data[9] = 0x03;
+
+    assert(memformat::JsonObjectSink(set).render() ==
+           R"({"state":"RUNNING","flags":"FAULT|OVERTEMP","text":"A\"B,C\\D"})");
+    assert(memformat::JsonArraySink(set).render() == R"(["RUNNING","FAULT|OVERTEMP","A\"B,C\\D"])");
+    assert(memformat::CsvRowSink(set).render() == "RUNNING,FAULT|OVERTEMP,\"A\"\"B,C\\D\"\n");
+    assert(memformat::CsvRowSink(set, '|').render() == "RUNNING|\"FAULT|OVERTEMP\"|\"A\"\"B,C\\D\"\n");
+    assert(memformat::LineProtocolSink(set, "m").render() ==
+           R"(m state="RUNNING",flags="FAULT|OVERTEMP",text="A\"B,C\\D")" "\n");
+}